@@ -0,0 +1,654 @@
+// ============================================================
+// SNAKE vs BLOCKS - Benchmarks
+// ============================================================
+// Mide el costo de la simulación, los spawns y el renderizado con
+// escenarios reproducibles (semillas fijas) y escribe los resultados
+// en JSON para comparar una versión contra otra.
+//
+// Uso:
+//   bench.exe [--out=archivo.json] [--filter=texto] [--quick] [--thumbnails=carpeta]
+//
+// Con --thumbnails se guarda además una miniatura (PPM, 1/8 de la
+// pantalla) de cada escenario de render, dibujada por software.
+// ============================================================
+
+#include "../src/game_state.hpp"
+#include "../src/particles.hpp"
+#include "../src/software_renderer.hpp"
+#include "../src/arena.hpp"
+#include <algorithm>          // sort, min_element
+#include <chrono>             // Medición de tiempo
+#include <cmath>              // sqrt
+#include <fstream>            // Escritura del JSON
+#include <iostream>           // Salida por consola
+#include <sstream>            // Construcción del JSON
+#include <string>
+#include <vector>
+
+// ============================================================
+// EJECUTOR DE BENCHMARKS
+// ============================================================
+
+// Resultado de un benchmark: tiempo por operación de cada lote medido
+struct BenchResult {
+    std::string name;             // Nombre del benchmark (grupo/escenario)
+    std::string params;           // Parámetros en formato JSON ({"len":256,...})
+    int opsPerBatch = 0;          // Operaciones por lote
+    std::vector<double> nsPerOp;  // Nanosegundos por operación de cada lote
+};
+
+class BenchRunner {
+public:
+    std::string filter;           // Solo ejecutar benchmarks cuyo nombre contenga esto
+    int batches = 25;             // Lotes medidos por benchmark
+    int warmupBatches = 3;        // Lotes descartados (calentamiento de caché)
+    std::string thumbnailDir;     // Carpeta para las miniaturas (vacío: no se guardan)
+    std::vector<BenchResult> results;
+
+    // Ejecuta un benchmark: en cada lote copia el estado inicial (sin medir)
+    // y mide opsPerBatch llamadas a op(estado)
+    template <class State, class Op>
+    void run(const std::string& name, const std::string& params,
+             const State& fixture, int opsPerBatch, Op op) {
+        if (!filter.empty() && name.find(filter) == std::string::npos) return;
+
+        BenchResult result;
+        result.name = name;
+        result.params = params;
+        result.opsPerBatch = opsPerBatch;
+
+        for (int b = 0; b < warmupBatches + batches; b++) {
+            State state = fixture;
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < opsPerBatch; i++) {
+                op(state);
+            }
+            auto end = std::chrono::steady_clock::now();
+            if (b < warmupBatches) continue;
+            double ns = std::chrono::duration<double, std::nano>(end - start).count();
+            result.nsPerOp.push_back(ns / opsPerBatch);
+        }
+
+        std::cout << name << " " << params << ": " << median(result.nsPerOp) << " ns/op" << std::endl;
+        results.push_back(result);
+    }
+
+    static double median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        return values.empty() ? 0.0 : values[values.size() / 2];
+    }
+
+    // Serializa todos los resultados como JSON
+    std::string toJson() const {
+        std::ostringstream out;
+        out << "{\n  \"compiler\": \"" << __VERSION__ << "\",\n";
+        out << "  \"batches\": " << batches << ",\n  \"benchmarks\": [\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchResult& r = results[i];
+            double sum = 0, sumSq = 0;
+            for (double v : r.nsPerOp) { sum += v; sumSq += v * v; }
+            double mean = sum / r.nsPerOp.size();
+            double stddev = std::sqrt(std::max(0.0, sumSq / r.nsPerOp.size() - mean * mean));
+            out << "    {\"name\": \"" << r.name << "\", \"params\": " << r.params
+                << ", \"ops_per_batch\": " << r.opsPerBatch
+                << ", \"ns_per_op_median\": " << median(r.nsPerOp)
+                << ", \"ns_per_op_min\": " << *std::min_element(r.nsPerOp.begin(), r.nsPerOp.end())
+                << ", \"ns_per_op_mean\": " << mean
+                << ", \"ns_per_op_stddev\": " << stddev << "}"
+                << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+        return out.str();
+    }
+};
+
+// ============================================================
+// ESCENARIOS (FIXTURES)
+// ============================================================
+
+// Desactiva todos los spawns para medir solo movimiento y colisiones
+template <class Game>
+void disableSpawns(Game& g) {
+    g.timers.cancel(TIMER_APPLE_SPAWN);
+    g.timers.cancel(TIMER_POWERUP_SPAWN);
+    g.timers.cancel(TIMER_OBSTACLE_SPAWN);
+    g.timers.cancel(TIMER_DESTROYER_SPAWN);
+}
+
+// Ciclo hamiltoniano sobre las filas [0, rows) (rows par): zigzag por las
+// columnas 1..COLS-1 y regreso por la columna 0. Una serpiente que lo sigue
+// nunca choca consigo misma mientras sea más corta que el ciclo.
+template <class Game>
+std::vector<SnakeSegment> hamiltonianCycle(int rows) {
+    std::vector<SnakeSegment> order;
+    int x = 0, y = 0;
+    for (int i = 0; i < Game::BOARD_COLS * rows; i++) {
+        order.push_back(SnakeSegment(x, y));
+        if (x == 0 && y > 0) y--;                                  // Subir por la columna 0
+        else if (x == 0) x++;                                      // Esquina: entrar al zigzag
+        else if (y % 2 == 0) { if (x < Game::BOARD_COLS - 1) x++; else y++; }
+        else if (x > 1) x--;
+        else if (y == rows - 1) x--;                               // Última fila: volver a la columna 0
+        else y++;
+    }
+    return order;
+}
+
+// Estado con una serpiente de 'length' segmentos sobre el ciclo y
+// 'obstacleCount' obstáculos en las filas que no usa el ciclo.
+// La serpiente avanza exactamente una celda en cada tick.
+template <class Game>
+struct UpdateFixture {
+    Game game;
+    std::vector<int> steer;     // Dirección a tomar desde cada celda del ciclo
+
+    UpdateFixture(int length, int obstacleCount, unsigned seed, int cycleRows) : game(seed) {
+        std::vector<SnakeSegment> order = hamiltonianCycle<Game>(cycleRows);
+        steer.assign(Game::CELL_COUNT, 1);
+        for (size_t i = 0; i < order.size(); i++) {
+            const SnakeSegment& a = order[i];
+            const SnakeSegment& b = order[(i + 1) % order.size()];
+            int dir = b.y < a.y ? 0 : b.x > a.x ? 1 : b.y > a.y ? 2 : 3;
+            steer[Game::cellIndex(a.x, a.y)] = dir;
+        }
+
+        // Reemplazar la serpiente inicial por una a lo largo del ciclo
+        game.cells.fill(CELL_EMPTY);
+        game.snake.clear();
+        for (int i = length - 1; i >= 0; i--) {
+            game.snake.push_back(order[i]);
+            game.cells[Game::cellIndex(order[i].x, order[i].y)] = CELL_SNAKE;
+        }
+        game.direction = game.nextDirection = steer[Game::cellIndex(order[length - 1].x, order[length - 1].y)];
+
+        // Obstáculos en las filas libres, en posiciones pseudoaleatorias
+        int placed = 0;
+        while (placed < obstacleCount) {
+            int x = game.randomInt(Game::BOARD_COLS);
+            int y = cycleRows + game.randomInt(Game::BOARD_ROWS - cycleRows);
+            if (game.cells[Game::cellIndex(x, y)] != CELL_EMPTY) continue;
+            game.obstacles.push_back(Obstacle(x, y));
+            game.obstacleRegions.add(x, y);
+            game.cells[Game::cellIndex(x, y)] = CELL_OBSTACLE;
+            placed++;
+        }
+
+        game.occupancy.load(game.cells, minimapLayer);
+        disableSpawns(game);
+        game.applesEaten = 90;    // Nivel 10 (62.5 celdas/s): un paso por tick de 0.016 s
+    }
+
+    // Un tick: girar según el ciclo y actualizar
+    void tick() {
+        const SnakeSegment& head = game.snake[0];
+        game.nextDirection = steer[Game::cellIndex(head.x, head.y)];
+        game.update(0.016f);
+    }
+};
+
+// Estado con el tablero ocupado por obstáculos hasta la densidad pedida
+// (0.0 - 1.0) y la serpiente quieta, para medir los caminos de spawn
+template <class Game>
+Game denseFixture(double density, unsigned seed) {
+    Game game(seed);
+    int target = static_cast<int>(density * Game::CELL_COUNT) - 1;
+    while ((int)game.obstacles.size() < target) {
+        int x = game.randomInt(Game::BOARD_COLS);
+        int y = game.randomInt(Game::BOARD_ROWS);
+        if (game.cells[Game::cellIndex(x, y)] != CELL_EMPTY) continue;
+        game.obstacles.push_back(Obstacle(x, y));
+        game.obstacleRegions.add(x, y);
+        game.cells[Game::cellIndex(x, y)] = CELL_OBSTACLE;
+    }
+    game.occupancy.load(game.cells, minimapLayer);
+    disableSpawns(game);
+    game.moveProgress = -1e9f;  // La serpiente no se mueve
+    return game;
+}
+
+// Estado con 'count' manzanas repartidas y MAGNET activo
+template <class Game>
+Game magnetFixture(int count, unsigned seed) {
+    Game game(seed);
+    while ((int)game.blocks.size() < count) {
+        int x = game.randomInt(Game::BOARD_COLS);
+        int y = game.randomInt(Game::BOARD_ROWS);
+        if (game.cells[Game::cellIndex(x, y)] != CELL_EMPTY) continue;
+        game.blocks.push_back(Block(x, y));
+        game.cells[Game::cellIndex(x, y)] = CELL_APPLE;
+    }
+    game.occupancy.load(game.cells, minimapLayer);
+    disableSpawns(game);
+    game.moveProgress = -1e9f;
+    game.activatePowerUp(MAGNET);
+    return game;
+}
+
+// Escenario de render: serpiente sobre el ciclo, 30 obstáculos y los
+// tres power-ups con duración activos (todas las filas del panel)
+template <class Game>
+UpdateFixture<Game> renderFixture(int length) {
+    const int cycleRows = (Game::BOARD_ROWS * 4 / 5) & ~1;
+    UpdateFixture<Game> fixture(length, 30, 2024, cycleRows);
+    fixture.game.activatePowerUp(WALL_PASS);
+    fixture.game.activatePowerUp(DOUBLE_SCORE);
+    fixture.game.activatePowerUp(MAGNET);
+    return fixture;
+}
+
+// Parámetros como objeto JSON
+std::string params(std::initializer_list<std::pair<const char*, double>> values) {
+    std::ostringstream out;
+    out << "{";
+    bool first = true;
+    for (const auto& kv : values) {
+        out << (first ? "" : ", ") << "\"" << kv.first << "\": " << kv.second;
+        first = false;
+    }
+    out << "}";
+    return out.str();
+}
+
+// ============================================================
+// GRUPOS DE BENCHMARKS
+// ============================================================
+
+// GameState::update con distintas longitudes de serpiente y obstáculos
+template <class Game>
+void benchUpdate(BenchRunner& runner, const char* board) {
+    const int cycleRows = (Game::BOARD_ROWS * 4 / 5) & ~1;   // Filas del ciclo (par)
+    const int cycleLength = Game::BOARD_COLS * cycleRows;
+    const int freeCells = Game::BOARD_COLS * (Game::BOARD_ROWS - cycleRows);
+
+    int lengths[] = {1, 16, 256, cycleLength * 9 / 10};
+    int obstacleCounts[] = {0, 30, freeCells};
+    for (int length : lengths) {
+        for (int obstacles : obstacleCounts) {
+            UpdateFixture<Game> fixture(length, obstacles, 12345, cycleRows);
+            runner.run(std::string("update/") + board,
+                       params({{"snake_length", length}, {"obstacles", obstacles}}),
+                       fixture, 256, [](UpdateFixture<Game>& f) { f.tick(); });
+        }
+    }
+}
+
+// Cada camino de spawn con el tablero casi lleno
+template <class Game>
+void benchSpawns(BenchRunner& runner) {
+    double densities[] = {0.5, 0.9, 0.99};
+    for (double density : densities) {
+        Game fixture = denseFixture<Game>(density, 777);
+        auto p = params({{"density", density}});
+        runner.run("spawn/apple", p, fixture, 256, [](Game& g) {
+            g.timers.schedule(TIMER_APPLE_SPAWN, 1);
+            g.update(0.016f);
+        });
+        runner.run("spawn/powerup", p, fixture, 256, [](Game& g) {
+            g.timers.schedule(TIMER_POWERUP_SPAWN, 1);
+            g.update(0.016f);
+        });
+        runner.run("spawn/obstacle", p, fixture, 256, [](Game& g) {
+            g.timers.schedule(TIMER_OBSTACLE_SPAWN, 1);
+            g.update(0.016f);
+        });
+        runner.run("spawn/obstacle_destroyer", p, fixture, 256, [](Game& g) {
+            g.timers.schedule(TIMER_DESTROYER_SPAWN, 1);
+            g.update(0.016f);
+        });
+    }
+}
+
+// Tablero con obstáculos puestos como en spawnObstacle() (sin encerrar
+// zonas) y las celdas libres que se van a consultar
+template <class Game>
+struct SealFixture {
+    ObstacleRegions<Game::BOARD_COLS, Game::BOARD_ROWS> regions;
+    std::vector<int> candidates;
+    std::vector<int> stack;
+    std::vector<char> seen;
+    size_t next = 0;
+
+    SealFixture(int obstacleCount, unsigned seed) : seen(Game::CELL_COUNT) {
+        Game game(seed);
+        int placed = 0;
+        while (placed < obstacleCount) {
+            int x = game.randomInt(Game::BOARD_COLS);
+            int y = game.randomInt(Game::BOARD_ROWS);
+            if (regions.blocked(x, y) || regions.wouldSeal(x, y)) continue;
+            regions.add(x, y);
+            placed++;
+        }
+        for (int i = 0; i < Game::CELL_COUNT; i++) {
+            if (!regions.blocked(i % Game::BOARD_COLS, i / Game::BOARD_COLS)) candidates.push_back(i);
+        }
+        stack.reserve(Game::CELL_COUNT);
+    }
+
+    int candidate() { return candidates[next++ % candidates.size()]; }
+};
+
+// Comprobar si un obstáculo encerraría una zona: union-find de
+// ObstacleRegions contra un flood fill del tablero completo por consulta
+template <class Game>
+void benchObstacleRegions(BenchRunner& runner, const char* board) {
+    int counts[] = {30, Game::MAX_OBSTACLES, Game::CELL_COUNT / 3};
+    for (int count : counts) {
+        SealFixture<Game> fixture(count, 4242);
+        auto p = params({{"obstacles", count}});
+        runner.run(std::string("obstacles/would_seal_") + board, p, fixture, 1024, [](SealFixture<Game>& f) {
+            int cell = f.candidate();
+            volatile bool seals = f.regions.wouldSeal(cell % Game::BOARD_COLS, cell / Game::BOARD_COLS);
+            (void)seals;
+        });
+        runner.run(std::string("obstacles/flood_fill_") + board, p, fixture, 64, [](SealFixture<Game>& f) {
+            int cell = f.candidate();
+            std::fill(f.seen.begin(), f.seen.end(), 0);
+            f.seen[cell] = 1;    // Como si ya tuviera el obstáculo
+            int start = f.candidates[cell == f.candidates[0] ? 1 : 0];
+            f.stack.assign(1, start);
+            f.seen[start] = 1;
+            volatile int count = 0;
+            while (!f.stack.empty()) {
+                int c = f.stack.back();
+                f.stack.pop_back();
+                count = count + 1;
+                int x = c % Game::BOARD_COLS, y = c / Game::BOARD_COLS;
+                const int dx[4] = {0, 1, 0, -1}, dy[4] = {-1, 0, 1, 0};
+                for (int d = 0; d < 4; d++) {
+                    int nx = x + dx[d], ny = y + dy[d];
+                    if (f.regions.blocked(nx, ny) || f.seen[Game::cellIndex(nx, ny)]) continue;
+                    f.seen[Game::cellIndex(nx, ny)] = 1;
+                    f.stack.push_back(Game::cellIndex(nx, ny));
+                }
+            }
+        });
+    }
+}
+
+// Minimapa del panel: un tick más la actualización de su textura,
+// incremental (solo los bloques que cambiaron) y recalculando la
+// pirámide y todos los texels en cada frame
+template <class Game>
+void benchMinimap(BenchRunner& runner, const char* board) {
+    struct MinimapFixture {
+        UpdateFixture<Game> update;
+        Minimap minimap;
+    };
+    int lengths[] = {16, 256};
+    for (int length : lengths) {
+        MinimapFixture fixture{renderFixture<Game>(length), Minimap()};
+        fixture.minimap.sync(fixture.update.game.occupancy);
+        auto p = params({{"snake_length", length}, {"obstacles", 30}});
+        runner.run(std::string("minimap/tick_sync_") + board, p, fixture, 256, [](MinimapFixture& f) {
+            f.update.tick();
+            f.minimap.sync(f.update.game.occupancy);
+        });
+        runner.run(std::string("minimap/tick_rebuild_") + board, p, fixture, 256, [](MinimapFixture& f) {
+            f.update.tick();
+            f.update.game.occupancy.load(f.update.game.cells, minimapLayer);
+            f.minimap.sync(f.update.game.occupancy);
+        });
+    }
+}
+
+// Ticks con MAGNET activo y muchas manzanas en el tablero
+template <class Game>
+void benchMagnet(BenchRunner& runner) {
+    int counts[] = {10, 100, Game::CELL_COUNT / 2};
+    for (int count : counts) {
+        Game fixture = magnetFixture<Game>(count, 4242);
+        runner.run("magnet/tick", params({{"blocks", count}}), fixture, 16, [](Game& g) {
+            g.activatePowerUp(MAGNET);  // Mantener el power-up activo
+            g.update(0.016f);
+        });
+    }
+}
+
+// Partida completa con entrada aleatoria (se reinicia al perder)
+template <class Game>
+void benchSession(BenchRunner& runner) {
+    struct Session {
+        Game game{1};
+        unsigned inputRng = 99;
+        unsigned restarts = 0;
+    };
+    runner.run("session/random_input", params({{"ticks", 4096}}), Session(), 4096, [](Session& s) {
+        s.inputRng = s.inputRng * 1103515245u + 12345u;
+        if ((s.inputRng >> 16) % 8 == 0) {
+            s.game.nextDirection = (s.inputRng >> 20) % 4;
+            if ((s.game.nextDirection + 2) % 4 == s.game.direction) s.game.nextDirection = s.game.direction;
+        }
+        s.game.update(0.016f);
+        if (s.game.gameOver) s.game = Game(2 + s.restarts++);
+    });
+}
+
+// draw()/drawUI() en un render target fuera de pantalla
+template <class Game>
+void benchRender(BenchRunner& runner) {
+    // No crear el contexto gráfico si el filtro excluye estos benchmarks
+    if (!runner.filter.empty() && std::string("render/drawUI").find(runner.filter) == std::string::npos &&
+        std::string("render/draw_grid").find(runner.filter) == std::string::npos &&
+        std::string("render/tick_paint").find(runner.filter) == std::string::npos) {
+        return;
+    }
+    sf::RenderTexture target;
+    if (!target.create(SCREEN_WIDTH, SCREEN_HEIGHT)) {
+        std::cerr << "render: RenderTexture no disponible, se omite" << std::endl;
+        return;
+    }
+    SfmlRenderer gpu(target);
+
+    int lengths[] = {16, 256};
+    for (int length : lengths) {
+        UpdateFixture<Game> fixture = renderFixture<Game>(length);
+        auto p = params({{"snake_length", length}, {"obstacles", 30}});
+        sf::RenderTexture* rt = &target;
+        SfmlRenderer* renderer = &gpu;
+        runner.run("render/draw", p, fixture, 64, [rt, renderer](UpdateFixture<Game>& f) {
+            renderer->clear(sf::Color::Black);
+            f.game.draw(*renderer);
+            rt->display();
+        });
+        runner.run("render/drawUI", p, fixture, 64, [rt, renderer](UpdateFixture<Game>& f) {
+            renderer->clear(sf::Color::Black);
+            f.game.drawUI(*renderer);
+            rt->display();
+        });
+        // --render=grid: el tablero es un quad y solo se suben los texels que cambian
+        static BoardTexture board(Game::BOARD_COLS, Game::BOARD_ROWS);
+        runner.run("render/draw_grid", p, fixture, 64, [rt, renderer](UpdateFixture<Game>& f) {
+            renderer->clear(sf::Color::Black);
+            f.game.drawGrid(*renderer, board);
+            rt->display();
+        });
+        // Un tick de juego y su tablero: todo con draw() o solo las celdas
+        // cambiadas sobre el contenido anterior (paintBoard)
+        runner.run("render/tick_draw", p, fixture, 64, [rt, renderer](UpdateFixture<Game>& f) {
+            f.tick();
+            renderer->clear(sf::Color::Black);
+            f.game.draw(*renderer);
+            rt->display();
+        });
+        runner.run("render/tick_paint", p, fixture, 64, [rt, renderer](UpdateFixture<Game>& f) {
+            f.tick();
+            if (f.game.paintBoard(*renderer)) rt->display();
+        });
+    }
+}
+
+// Frame completo dibujado por software (sin GPU): a tamaño de pantalla
+// y como miniatura de 1/8, la que guardan las herramientas por lotes
+template <class Game>
+void benchSoftwareRender(BenchRunner& runner) {
+    const unsigned thumbW = (SCREEN_WIDTH + 7) / 8, thumbH = (SCREEN_HEIGHT + 7) / 8;
+    static SoftwareRenderer frame(SCREEN_WIDTH, SCREEN_HEIGHT);
+    static SoftwareRenderer thumbnail(thumbW, thumbH, 1.0f / 8);
+
+    int lengths[] = {16, 256};
+    for (int length : lengths) {
+        UpdateFixture<Game> fixture = renderFixture<Game>(length);
+        auto p = params({{"snake_length", length}, {"obstacles", 30}});
+        runner.run("render/software_frame", p, fixture, 16, [](UpdateFixture<Game>& f) {
+            frame.clear(sf::Color::Black);
+            f.game.draw(frame);
+            f.game.drawUI(frame);
+        });
+        runner.run("render/thumbnail", p, fixture, 256, [](UpdateFixture<Game>& f) {
+            thumbnail.clear(sf::Color::Black);
+            f.game.draw(thumbnail);
+            f.game.drawUI(thumbnail);
+        });
+        static BoardTexture board(Game::BOARD_COLS, Game::BOARD_ROWS);
+        runner.run("render/software_grid", p, fixture, 16, [](UpdateFixture<Game>& f) {
+            frame.clear(sf::Color::Black);
+            f.game.drawGrid(frame, board);
+            f.game.drawUI(frame);
+        });
+        runner.run("render/software_tick_draw", p, fixture, 64, [](UpdateFixture<Game>& f) {
+            f.tick();
+            frame.clear(sf::Color::Black);
+            f.game.draw(frame);
+        });
+        runner.run("render/software_tick_paint", p, fixture, 64, [](UpdateFixture<Game>& f) {
+            f.tick();
+            f.game.paintBoard(frame);
+        });
+
+        if (!runner.thumbnailDir.empty()) {
+            std::string path = runner.thumbnailDir + "/render_" + std::to_string(length) + ".ppm";
+            thumbnail.clear(sf::Color::Black);
+            fixture.game.draw(thumbnail);
+            fixture.game.drawUI(thumbnail);
+            if (!thumbnail.savePpm(path)) std::cerr << "Error: no se pudo escribir " << path << std::endl;
+        }
+    }
+}
+
+// Integración y dibujo del sistema de partículas con el pool casi lleno.
+// El pool no se copia: todos los lotes comparten el mismo y cada
+// operación lo deja con la misma cantidad de partículas vivas.
+void benchParticles(BenchRunner& runner) {
+    static ParticleSystem particles;
+    struct Pool { ParticleSystem* system; };
+    Pool pool{&particles};
+
+    const int live = 30000;
+    particles.clear();
+    particles.burst(400, 300, live, 200.0f, sf::Color::Cyan, 1e6f);  // No mueren durante la medición
+    runner.run("particles/update", params({{"live", live}}), pool, 256, [](Pool& p) {
+        p.system->update(0.016f);
+    });
+
+    // Ráfaga de OBSTACLE_DESTROYER con el máximo de obstáculos del tablero
+    // estándar (como en spawnEffects)
+    const int obstacles = GameState::MAX_OBSTACLES;
+    runner.run("particles/destroyer_burst", params({{"obstacles", obstacles}}), pool, 64, [obstacles](Pool& p) {
+        p.system->clear();
+        int count = ParticleSystem::perBurst(obstacles, 400);
+        for (int i = 0; i < obstacles; i++) {
+            p.system->burst(5.0f * i, 300, count - count / 4, 260.0f, sf::Color::Cyan, 1.0f);
+            p.system->burst(5.0f * i, 300, count / 4, 140.0f, sf::Color::White, 0.7f);
+        }
+    });
+
+    if (!runner.filter.empty() && std::string("particles/draw").find(runner.filter) == std::string::npos) {
+        return;
+    }
+    sf::RenderTexture target;
+    if (!target.create(SCREEN_WIDTH, SCREEN_HEIGHT)) {
+        std::cerr << "particles: RenderTexture no disponible, se omite" << std::endl;
+        return;
+    }
+    particles.clear();
+    particles.burst(400, 300, live, 200.0f, sf::Color::Cyan, 1e6f);
+    SfmlRenderer gpu(target);
+    sf::RenderTexture* rt = &target;
+    SfmlRenderer* renderer = &gpu;
+    runner.run("particles/draw", params({{"live", live}}), pool, 64, [rt, renderer](Pool& p) {
+        renderer->clear(sf::Color::Black);
+        p.system->draw(*renderer);
+        rt->display();
+    });
+}
+
+// Ticks del modo arena con distintas cantidades de serpientes, con el
+// pool de hilos y en un solo hilo
+void benchArena(BenchRunner& runner) {
+    static WorkerPool pool;
+    int counts[] = {100, 400, 1000};
+    for (int count : counts) {
+        Arena fixture(count, 0, 77);
+        auto p = params({{"snakes", count}, {"threads", pool.size()}});
+        runner.run("arena/tick", p, fixture, 32, [](Arena& a) { a.tick(&pool); });
+        runner.run("arena/tick_serial", params({{"snakes", count}}), fixture, 32, [](Arena& a) { a.tick(); });
+    }
+
+    // Tablero de la arena por software: un quad por segmento contra la
+    // textura de un texel por celda (después de 300 movimientos)
+    static SoftwareRenderer frame(SCREEN_WIDTH, SCREEN_HEIGHT);
+    static BoardTexture board(Arena::BOARD_COLS, Arena::BOARD_ROWS);
+    for (int count : counts) {
+        Arena fixture(count, 0, 77);
+        for (int i = 0; i < 300; i++) fixture.tick(&pool);
+        auto p = params({{"snakes", count}});
+        runner.run("arena/draw_cells", p, fixture, 16, [](Arena& a) {
+            frame.clear(sf::Color::Black);
+            a.draw(frame);
+        });
+        runner.run("arena/draw_grid", p, fixture, 16, [](Arena& a) {
+            frame.clear(sf::Color::Black);
+            a.drawGrid(frame, board);
+        });
+    }
+}
+
+// ============================================================
+// PUNTO DE ENTRADA
+// ============================================================
+
+int main(int argc, char* argv[]) {
+    BenchRunner runner;
+    std::string outPath;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--out=", 0) == 0) outPath = arg.substr(6);
+        else if (arg.rfind("--filter=", 0) == 0) runner.filter = arg.substr(9);
+        else if (arg == "--quick") { runner.batches = 5; runner.warmupBatches = 1; }
+        else if (arg.rfind("--thumbnails=", 0) == 0) runner.thumbnailDir = arg.substr(13);
+        else {
+            std::cerr << "Uso: bench [--out=archivo.json] [--filter=texto] [--quick] [--thumbnails=carpeta]" << std::endl;
+            return 1;
+        }
+    }
+
+    calculateScaling();
+
+    benchUpdate<GameState>(runner, "standard");
+    benchUpdate<LargeGameState>(runner, "large");
+    benchSpawns<GameState>(runner);
+    benchObstacleRegions<GameState>(runner, "standard");
+    benchObstacleRegions<LargeGameState>(runner, "large");
+    benchMinimap<LargeGameState>(runner, "large");
+    benchMagnet<GameState>(runner);
+    benchSession<GameState>(runner);
+    benchRender<GameState>(runner);
+    benchSoftwareRender<GameState>(runner);
+    benchParticles(runner);
+    benchArena(runner);
+
+    std::string json = runner.toJson();
+    if (!outPath.empty()) {
+        std::ofstream file(outPath);
+        if (!file) {
+            std::cerr << "Error: no se pudo escribir " << outPath << std::endl;
+            return 1;
+        }
+        file << json;
+        std::cout << "Resultados guardados en " << outPath << std::endl;
+    } else {
+        std::cout << json;
+    }
+    return 0;
+}
@@ -0,0 +1,453 @@
+// ============================================================
+// SNAKE vs BLOCKS - Prueba de resistencia (soak)
+// ============================================================
+// Juega partidas sin ventana durante el tiempo pedido (horas si hace
+// falta), una tras otra con semillas derivadas de --seed, y en cada tick
+// comprueba los invariantes del estado:
+//
+// - Ninguna celda tiene dos entidades y 'cells' coincide con las listas.
+// - Todas las entidades están dentro del tablero.
+// - Los segmentos de la serpiente son contiguos y su longitud es
+//   1 + manzanas comidas con la cabeza (applesEaten menos las de MAGNET).
+// - No hay más obstáculos que MAX_OBSTACLES y las celdas sin obstáculo
+//   forman una sola zona conectada (se comprueba cuando cambian).
+//
+// Cada --sample segundos anota ticks/s y memoria residente (RSS). Al
+// terminar (o con Ctrl+C) escribe un resumen JSON; con --baseline lo
+// compara con el de la versión anterior.
+//
+// Uso:
+//   soak.exe [--seconds=3600] [--ticks=N] [--board=standard] [--input=bot|random]
+//            [--seed=1] [--sample=10] [--render] [--out=soak.json]
+//            [--baseline=anterior.json] [--tolerance=0.10] [--max-rss-growth=4096]
+//
+// Código de salida: 0 bien, 1 uso o archivo, 2 invariante roto,
+// 3 regresión (ticks/s por debajo de la tolerancia, caída de ticks/s
+// durante la prueba o RSS que crece más de --max-rss-growth KB).
+// ============================================================
+
+#include "../src/game_state.hpp"
+#include "../src/autopilot.hpp"
+#include "../src/software_renderer.hpp"
+#include <algorithm>          // min, max
+#include <chrono>             // Reloj de pared
+#include <csignal>            // Ctrl+C termina con resumen
+#include <cstdio>             // snprintf, FILE*
+#include <cstdlib>            // strtod
+#include <fstream>            // Resumen y línea base
+#include <iostream>           // Salida por consola
+#include <sstream>            // Construcción del JSON
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define PSAPI_VERSION 2       // GetProcessMemoryInfo desde kernel32 (sin -lpsapi)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>           // sysconf (tamaño de página)
+#endif
+
+// ============================================================
+// MEMORIA RESIDENTE
+// ============================================================
+
+// KB de memoria física que usa el proceso (0 si no se puede medir)
+long residentKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<long>(counters.WorkingSetSize / 1024);
+    }
+    return 0;
+#else
+    // /proc/self/statm: tamaño total y páginas residentes
+    long pages = 0, resident = 0;
+    FILE* file = std::fopen("/proc/self/statm", "r");
+    if (!file) return 0;
+    bool ok = std::fscanf(file, "%ld %ld", &pages, &resident) == 2;
+    std::fclose(file);
+    return ok ? resident * (sysconf(_SC_PAGESIZE) / 1024) : 0;
+#endif
+}
+
+// ============================================================
+// INVARIANTES
+// ============================================================
+
+// Comprueba el estado después de un tick. Guarda en 'error' el primer
+// invariante roto y devuelve false. 'stamp' marca las celdas ocupadas
+// (una generación por llamada, sin limpiar el arreglo).
+template <class Game>
+class InvariantChecker {
+public:
+    InvariantChecker() : stamp(Game::CELL_COUNT, 0), reached(Game::CELL_COUNT, 0) {
+        pending.reserve(Game::CELL_COUNT);
+    }
+
+    bool check(const Game& game, std::string& error) {
+        generation++;
+        int entities = 0;
+
+        // Serpiente: dentro, sin repetir celdas, contigua y con su longitud
+        for (size_t i = 0; i < game.snake.size(); i++) {
+            const SnakeSegment& s = game.snake[i];
+            if (!claim(s.x, s.y, CELL_SNAKE, game, "segmento", error)) return false;
+            if (i > 0 && !adjacent(game.snake[i - 1], s)) {
+                return fail(error, "segmentos no contiguos en ", s.x, s.y);
+            }
+        }
+        entities += static_cast<int>(game.snake.size());
+        int expectedLength = 1 + game.applesEaten - game.magnetPickups;
+        if (static_cast<int>(game.snake.size()) != expectedLength) {
+            char text[128];
+            std::snprintf(text, sizeof(text), "longitud %d con %d manzanas (%d por MAGNET)",
+                          (int)game.snake.size(), game.applesEaten, game.magnetPickups);
+            error = text;
+            return false;
+        }
+
+        for (const Block& b : game.blocks) {
+            if (!claim(b.x, b.y, CELL_APPLE, game, "manzana", error)) return false;
+        }
+        for (const PowerUp& p : game.powerUps) {
+            if (!claim(p.x, p.y, powerUpCell(p.type), game, "power-up", error)) return false;
+        }
+        for (const Obstacle& o : game.obstacles) {
+            if (!claim(o.x, o.y, CELL_OBSTACLE, game, "obstáculo", error)) return false;
+        }
+        entities += static_cast<int>(game.blocks.size() + game.powerUps.size() + game.obstacles.size());
+
+        if ((int)game.obstacles.size() > Game::MAX_OBSTACLES) {
+            return fail(error, "demasiados obstáculos, el último en ", game.obstacles.back().x, game.obstacles.back().y);
+        }
+        if ((int)game.obstacles.size() != checkedObstacles) {
+            checkedObstacles = static_cast<int>(game.obstacles.size());
+            if (!game.obstacles.empty() && !freeSpaceConnected(game)) {
+                return fail(error, "zona encerrada por el obstáculo en ", game.obstacles.back().x,
+                            game.obstacles.back().y);
+            }
+        }
+
+        // Ninguna celda ocupada que no esté en las listas
+        int occupied = 0;
+        for (unsigned char cell : game.cells) occupied += cell != CELL_EMPTY;
+        if (occupied != entities) {
+            char text[96];
+            std::snprintf(text, sizeof(text), "%d celdas ocupadas para %d entidades", occupied, entities);
+            error = text;
+            return false;
+        }
+        return true;
+    }
+
+private:
+    std::vector<unsigned> stamp;
+    unsigned generation = 0;
+    std::vector<unsigned> reached;          // Generación del último flood fill que pasó por la celda
+    std::vector<int> pending;
+    unsigned floodGeneration = 0;
+    int checkedObstacles = 0;               // Obstáculos en la última comprobación de conectividad
+
+    // Flood fill por 4 vecinos sin wrap: alcanza todas las celdas sin obstáculo
+    bool freeSpaceConnected(const Game& game) {
+        floodGeneration++;
+        int start = 0;
+        while (start < Game::CELL_COUNT && game.cells[start] == CELL_OBSTACLE) start++;
+        if (start == Game::CELL_COUNT) return true;
+        pending.assign(1, start);
+        reached[start] = floodGeneration;
+        int count = 0;
+        while (!pending.empty()) {
+            int cell = pending.back();
+            pending.pop_back();
+            count++;
+            int x = cell % Game::BOARD_COLS, y = cell / Game::BOARD_COLS;
+            const int dx[4] = {0, 1, 0, -1}, dy[4] = {-1, 0, 1, 0};
+            for (int d = 0; d < 4; d++) {
+                int nx = x + dx[d], ny = y + dy[d];
+                if (!Game::inBounds(nx, ny)) continue;
+                int next = Game::cellIndex(nx, ny);
+                if (reached[next] == floodGeneration || game.cells[next] == CELL_OBSTACLE) continue;
+                reached[next] = floodGeneration;
+                pending.push_back(next);
+            }
+        }
+        return count == Game::CELL_COUNT - static_cast<int>(game.obstacles.size());
+    }
+
+    bool claim(int x, int y, unsigned char type, const Game& game, const char* what, std::string& error) {
+        if (!Game::inBounds(x, y)) return fail(error, std::string(what) + " fuera del tablero en ", x, y);
+        int index = Game::cellIndex(x, y);
+        if (stamp[index] == generation) return fail(error, std::string(what) + " en una celda repetida ", x, y);
+        stamp[index] = generation;
+        if (game.cells[index] != type) return fail(error, std::string(what) + " no coincide con 'cells' en ", x, y);
+        return true;
+    }
+
+    // Vecinos en el tablero o a través del borde (WALL_PASS)
+    static bool adjacent(const SnakeSegment& a, const SnakeSegment& b) {
+        int dx = std::abs(a.x - b.x), dy = std::abs(a.y - b.y);
+        if (dx == Game::BOARD_COLS - 1) dx = 1;
+        if (dy == Game::BOARD_ROWS - 1) dy = 1;
+        return dx + dy == 1;
+    }
+
+    static bool fail(std::string& error, const std::string& what, int x, int y) {
+        error = what + "(" + std::to_string(x) + ", " + std::to_string(y) + ")";
+        return false;
+    }
+};
+
+// ============================================================
+// PRUEBA
+// ============================================================
+
+struct SoakOptions {
+    double seconds = 3600;        // Duración (reloj de pared)
+    long long maxTicks = 0;       // 0: sin límite de ticks
+    std::string board = "standard";
+    std::string input = "bot";    // bot | random
+    unsigned seed = 1;
+    double sampleSeconds = 10;
+    bool render = false;          // También dibuja cada tick (miniatura por software)
+    std::string outPath = "soak_results.json";
+    std::string baselinePath;
+    double tolerance = 0.10;      // Caída de ticks/s permitida (10%)
+    long maxRssGrowthKb = 4096;   // Crecimiento de RSS permitido durante la prueba
+};
+
+struct SoakSample {
+    double seconds;
+    long long ticks;
+    double ticksPerSecond;
+    long rssKb;
+};
+
+struct SoakResult {
+    long long ticks = 0;
+    long long games = 0;
+    double seconds = 0;
+    std::string violation;        // Vacío si no se rompió ningún invariante
+    long long violationTick = 0;
+    unsigned violationSeed = 0;
+    std::vector<SoakSample> samples;
+};
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+void onInterrupt(int) { stopRequested = 1; }
+
+// Semilla de la partida número 'game' (reproducible con --seed)
+unsigned gameSeed(unsigned seed, long long game) {
+    return seed * 2654435761u + static_cast<unsigned>(game) * 40503u + 1;
+}
+
+template <class Game>
+SoakResult runSoak(const SoakOptions& options) {
+    using Clock = std::chrono::steady_clock;
+    SoakResult result;
+    InvariantChecker<Game> checker;
+    Game game(gameSeed(options.seed, 0));
+    SoftwareRenderer thumbnail((SCREEN_WIDTH + 7) / 8, (SCREEN_HEIGHT + 7) / 8, 1.0f / 8);
+    unsigned inputRng = options.seed | 1;
+    bool bot = options.input == "bot";
+
+    auto start = Clock::now();
+    auto lastSample = start;
+    long long lastSampleTicks = 0;
+    double nextSample = options.sampleSeconds;
+    std::string error;
+
+    while (!stopRequested && (options.maxTicks == 0 || result.ticks < options.maxTicks)) {
+        if (bot) {
+            game.nextDirection = autopilotDirection(game);
+        } else {
+            inputRng ^= inputRng << 13;
+            inputRng ^= inputRng >> 17;
+            inputRng ^= inputRng << 5;
+            if (inputRng % 8 == 0) game.nextDirection = (game.direction + (inputRng & 16 ? 1 : 3)) % 4;
+        }
+        game.update(TICK_SECONDS);
+        result.ticks++;
+
+        if (!checker.check(game, error)) {
+            result.violation = error;
+            result.violationTick = result.ticks;
+            result.violationSeed = game.seed;
+            break;
+        }
+        if (options.render) {
+            game.paintBoard(thumbnail);
+            game.drawUI(thumbnail);
+        }
+        if (game.gameOver) {
+            result.games++;
+            game.reset(gameSeed(options.seed, result.games));
+        }
+
+        // El reloj se consulta cada 4096 ticks
+        if ((result.ticks & 4095) != 0) continue;
+        auto now = Clock::now();
+        double elapsed = std::chrono::duration<double>(now - start).count();
+        if (elapsed >= nextSample) {
+            double window = std::chrono::duration<double>(now - lastSample).count();
+            result.samples.push_back(SoakSample{elapsed, result.ticks,
+                                                (result.ticks - lastSampleTicks) / window, residentKb()});
+            std::cout << "[" << static_cast<long>(elapsed) << " s] " << result.ticks << " ticks, "
+                      << static_cast<long>(result.samples.back().ticksPerSecond) << " ticks/s, "
+                      << result.samples.back().rssKb << " KB" << std::endl;
+            lastSample = now;
+            lastSampleTicks = result.ticks;
+            nextSample = elapsed + options.sampleSeconds;
+        }
+        if (elapsed >= options.seconds) break;
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+// ============================================================
+// RESUMEN
+// ============================================================
+
+// Promedio de ticks/s de las muestras [from, to)
+double averageRate(const std::vector<SoakSample>& samples, size_t from, size_t to) {
+    double sum = 0;
+    for (size_t i = from; i < to; i++) sum += samples[i].ticksPerSecond;
+    return to > from ? sum / (to - from) : 0;
+}
+
+// Valor numérico de "key" en un JSON plano (0 si no está)
+double jsonNumber(const std::string& json, const std::string& key) {
+    size_t at = json.find("\"" + key + "\":");
+    if (at == std::string::npos) return 0;
+    return std::strtod(json.c_str() + at + key.size() + 3, nullptr);
+}
+
+int main(int argc, char* argv[]) {
+    SoakOptions options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--seconds=", 0) == 0) options.seconds = std::atof(arg.c_str() + 10);
+        else if (arg.rfind("--ticks=", 0) == 0) options.maxTicks = std::atoll(arg.c_str() + 8);
+        else if (arg.rfind("--board=", 0) == 0) options.board = arg.substr(8);
+        else if (arg.rfind("--input=", 0) == 0) options.input = arg.substr(8);
+        else if (arg.rfind("--seed=", 0) == 0) options.seed = static_cast<unsigned>(std::atol(arg.c_str() + 7));
+        else if (arg.rfind("--sample=", 0) == 0) options.sampleSeconds = std::atof(arg.c_str() + 9);
+        else if (arg == "--render") options.render = true;
+        else if (arg.rfind("--out=", 0) == 0) options.outPath = arg.substr(6);
+        else if (arg.rfind("--baseline=", 0) == 0) options.baselinePath = arg.substr(11);
+        else if (arg.rfind("--tolerance=", 0) == 0) options.tolerance = std::atof(arg.c_str() + 12);
+        else if (arg.rfind("--max-rss-growth=", 0) == 0) options.maxRssGrowthKb = std::atol(arg.c_str() + 17);
+        else {
+            std::cerr << "Uso: soak [--seconds=3600] [--ticks=N] [--board=small|standard|large] [--input=bot|random]\n"
+                         "            [--seed=1] [--sample=10] [--render] [--out=soak_results.json]\n"
+                         "            [--baseline=anterior.json] [--tolerance=0.10] [--max-rss-growth=4096]" << std::endl;
+            return 1;
+        }
+    }
+    if ((options.input != "bot" && options.input != "random") || options.sampleSeconds <= 0) {
+        std::cerr << "Error: --input debe ser bot o random y --sample mayor que 0" << std::endl;
+        return 1;
+    }
+
+    calculateScaling();
+    std::signal(SIGINT, onInterrupt);
+    long rssStart = residentKb();
+
+    SoakResult result;
+    if (options.board == "small") result = runSoak<SmallGameState>(options);
+    else if (options.board == "large") result = runSoak<LargeGameState>(options);
+    else result = runSoak<GameState>(options);
+
+    // Ticks/s global, del primer y del último cuarto de las muestras
+    const std::vector<SoakSample>& samples = result.samples;
+    double rate = result.seconds > 0 ? result.ticks / result.seconds : 0;
+    size_t quarter = std::max<size_t>(1, samples.size() / 4);
+    double firstRate = averageRate(samples, 0, std::min(quarter, samples.size()));
+    double lastRate = averageRate(samples, samples.size() - std::min(quarter, samples.size()), samples.size());
+    double decay = firstRate > 0 ? (firstRate - lastRate) / firstRate : 0;
+    long rssEnd = residentKb();
+    long rssPeak = rssStart;
+    for (const SoakSample& s : samples) rssPeak = std::max(rssPeak, s.rssKb);
+    long rssGrowth = samples.empty() ? 0 : rssEnd - samples.front().rssKb;
+
+    // Regresiones: dentro de la prueba y contra la versión anterior
+    std::vector<std::string> regressions;
+    if (samples.size() >= 4 && decay > options.tolerance) {
+        regressions.push_back("ticks/s cayó " + std::to_string(static_cast<int>(decay * 100)) + "% durante la prueba");
+    }
+    if (rssGrowth > options.maxRssGrowthKb) {
+        regressions.push_back("RSS creció " + std::to_string(rssGrowth) + " KB durante la prueba");
+    }
+    double baselineRate = 0, baselineRss = 0;
+    if (!options.baselinePath.empty()) {
+        std::ifstream file(options.baselinePath);
+        if (!file) {
+            std::cerr << "Error: no se pudo leer " << options.baselinePath << std::endl;
+            return 1;
+        }
+        std::stringstream text;
+        text << file.rdbuf();
+        baselineRate = jsonNumber(text.str(), "ticks_per_second");
+        baselineRss = jsonNumber(text.str(), "rss_kb_peak");
+        if (baselineRate > 0 && rate < baselineRate * (1 - options.tolerance)) {
+            regressions.push_back("ticks/s " + std::to_string(static_cast<long>(rate)) + " contra " +
+                                  std::to_string(static_cast<long>(baselineRate)) + " de la línea base");
+        }
+    }
+
+    std::ostringstream out;
+    out << "{\n  \"compiler\": \"" << __VERSION__ << "\",\n"
+        << "  \"board\": \"" << options.board << "\",\n"
+        << "  \"input\": \"" << options.input << "\",\n"
+        << "  \"seed\": " << options.seed << ",\n"
+        << "  \"render\": " << (options.render ? "true" : "false") << ",\n"
+        << "  \"seconds\": " << result.seconds << ",\n"
+        << "  \"ticks\": " << result.ticks << ",\n"
+        << "  \"games\": " << result.games << ",\n"
+        << "  \"ticks_per_second\": " << rate << ",\n"
+        << "  \"ticks_per_second_first\": " << firstRate << ",\n"
+        << "  \"ticks_per_second_last\": " << lastRate << ",\n"
+        << "  \"rss_kb_start\": " << rssStart << ",\n"
+        << "  \"rss_kb_peak\": " << rssPeak << ",\n"
+        << "  \"rss_kb_end\": " << rssEnd << ",\n";
+    if (!options.baselinePath.empty()) {
+        out << "  \"baseline_ticks_per_second\": " << baselineRate << ",\n"
+            << "  \"baseline_rss_kb_peak\": " << baselineRss << ",\n";
+    }
+    out << "  \"violation\": \"" << result.violation << "\",\n";
+    if (!result.violation.empty()) {
+        out << "  \"violation_tick\": " << result.violationTick << ",\n"
+            << "  \"violation_game_seed\": " << result.violationSeed << ",\n";
+    }
+    out << "  \"regressions\": [";
+    for (size_t i = 0; i < regressions.size(); i++) out << (i ? ", " : "") << "\"" << regressions[i] << "\"";
+    out << "],\n  \"samples\": [\n";
+    for (size_t i = 0; i < samples.size(); i++) {
+        const SoakSample& s = samples[i];
+        out << "    {\"seconds\": " << s.seconds << ", \"ticks\": " << s.ticks
+            << ", \"ticks_per_second\": " << s.ticksPerSecond << ", \"rss_kb\": " << s.rssKb << "}"
+            << (i + 1 < samples.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+
+    std::ofstream file(options.outPath);
+    if (!file) {
+        std::cerr << "Error: no se pudo escribir " << options.outPath << std::endl;
+        return 1;
+    }
+    file << out.str();
+
+    std::cout << result.ticks << " ticks en " << result.games << " partidas, "
+              << static_cast<long>(rate) << " ticks/s, RSS máximo " << rssPeak << " KB" << std::endl;
+    std::cout << "Resumen guardado en " << options.outPath << std::endl;
+    if (!result.violation.empty()) {
+        std::cout << "FAIL invariante en el tick " << result.violationTick << " (partida con semilla "
+                  << result.violationSeed << "): " << result.violation << std::endl;
+        return 2;
+    }
+    for (const std::string& regression : regressions) std::cout << "REGRESIÓN " << regression << std::endl;
+    return regressions.empty() ? 0 : 3;
+}
@@ -0,0 +1,40 @@
+// ============================================================
+// SNAKE vs BLOCKS - Contador de asignaciones (operator new global)
+// ============================================================
+#include "alloc_check.hpp"
+
+#ifdef SNAKE_ALLOC_CHECK
+#include <cstdlib>            // malloc, free
+#include <new>                // bad_alloc, nothrow_t
+
+namespace {
+// Contador por hilo: el hilo de la música o el escritor de fondo no cuentan
+thread_local long allocationsOnThisThread = 0;
+
+void* countedAlloc(std::size_t size) {
+    allocationsOnThisThread++;
+    void* memory = std::malloc(size ? size : 1);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+}  // namespace
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    allocationsOnThisThread++;
+    return std::malloc(size ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    allocationsOnThisThread++;
+    return std::malloc(size ? size : 1);
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+long AllocCheck::threadAllocations() { return allocationsOnThisThread; }
+#else
+long AllocCheck::threadAllocations() { return 0; }
+#endif
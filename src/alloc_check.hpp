@@ -0,0 +1,29 @@
+// ============================================================
+// SNAKE vs BLOCKS - Verificación de asignaciones de memoria
+// ============================================================
+// En la compilación instrumentada (make alloccheck, que define
+// SNAKE_ALLOC_CHECK) se reemplaza el operator new global para contar
+// cuántas reservas hace el hilo principal. El bucle del juego usa el
+// contador para fallar si un frame en estado estable reserva memoria.
+// En la compilación normal todo esto no hace nada.
+// ============================================================
+#pragma once
+
+namespace AllocCheck {
+
+// Verdadero solo en la compilación instrumentada
+#ifdef SNAKE_ALLOC_CHECK
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+// Frames de calentamiento antes de exigir cero reservas
+// (texturas, formas y buffers se crean en los primeros frames)
+constexpr int WARMUP_FRAMES = 120;
+
+// Número de llamadas a operator new hechas por el hilo actual
+// (siempre 0 en la compilación normal)
+long threadAllocations();
+
+}  // namespace AllocCheck
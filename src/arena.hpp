@@ -0,0 +1,616 @@
+// ============================================================
+// SNAKE vs BLOCKS - Modo arena (muchas serpientes)
+// ============================================================
+// Cientos de serpientes (bots y jugadores locales) en un mismo tablero,
+// hasta que queda una sola ("battle royale").
+//
+// Cada tick tiene tres fases:
+// 1. Planificar: cada serpiente elige su celda destino leyendo el
+//    tablero (sin escribirlo). Las serpientes se reparten entre los
+//    hilos del WorkerPool; cada una solo escribe sus propios campos.
+// 2. Resolver conflictos (un hilo): se compara cada destino con la
+//    ocupación del tick anterior. Mueren las que chocan con una pared,
+//    un obstáculo o un cuerpo, y todas las que eligen la misma celda
+//    (choque de cabezas). La cola de una serpiente que no crece se
+//    considera libre porque se mueve en el mismo tick.
+// 3. Aplicar: mover colas y cabezas de las sobrevivientes y convertir
+//    en manzanas los cuerpos de las que murieron.
+//
+// El resultado no depende del orden de las serpientes ni de cuántos
+// hilos haya. Los cuerpos se guardan en el propio tablero: cada celda
+// de serpiente apunta a la siguiente hacia la cabeza, así mover una
+// serpiente es O(1) sin importar su largo y el tick cuesta
+// O(serpientes), no O(largo total²).
+// ============================================================
+#pragma once
+
+#include "game_state.hpp"     // CellType, escala de pantalla, HudBatch
+#include "minimap.hpp"        // Minimapa del panel
+#include "renderer.hpp"       // Destino de dibujo
+#include "worker_pool.hpp"    // Fase de planificación en paralelo
+#include <algorithm>          // max, min
+#include <climits>            // INT_MIN
+#include <cstdint>            // uint64_t
+#include <cstdio>             // snprintf
+#include <vector>
+
+template <int COLS, int ROWS>
+class BasicArena {
+public:
+    // ========== DIMENSIONES ==========
+    static constexpr int BOARD_COLS = COLS;
+    static constexpr int BOARD_ROWS = ROWS;
+    static constexpr int CELL_COUNT = COLS * ROWS;
+    static constexpr int MAX_SNAKES = 1024;         // Bots + jugadores
+    static constexpr int MAX_PLAYERS = 2;           // Jugadores locales (flechas y WASD)
+    static constexpr int START_LENGTH = 3;          // Largo inicial de cada serpiente
+    static constexpr int NONE = -1;                 // Sin celda (fuera del tablero)
+
+    static constexpr int cellIndex(int x, int y) { return y * COLS + x; }
+
+    // ========== SERPIENTE ==========
+    struct ArenaSnake {
+        int head = 0, tail = 0;         // Celdas de la cabeza y de la cola
+        int length = 0;
+        int direction = 1;              // 0=arriba, 1=derecha, 2=abajo, 3=izquierda
+        int nextDirection = 1;          // Elegida por el jugador o por el bot
+        int target = NONE;              // Celda a la que se mueve este tick
+        int applesEaten = 0;
+        unsigned rngState = 1;          // Generador propio (decisiones del bot)
+        bool alive = false;
+        bool player = false;            // Controlada por teclado
+        bool grows = false;             // Come una manzana este tick
+        bool dies = false;              // Muere este tick
+    };
+
+    // ========== ESTADO ==========
+    std::vector<ArenaSnake> snakes;             // Índice = id de la serpiente
+    std::vector<unsigned char> cells;           // CellType por celda
+    std::vector<unsigned short> owner;          // Serpiente de cada celda CELL_SNAKE
+    std::vector<int> towardHead;                // Siguiente segmento hacia la cabeza
+    std::vector<int> apples;                    // Celdas con manzana
+    std::vector<int> obstacles;                 // Celdas con obstáculo (fijos)
+    OccupancyPyramid<COLS, ROWS> occupancy;     // Conteos por bloque para el minimapa
+    int aliveCount = 0;
+    int playerCount = 0;
+    unsigned tickCount = 0;
+    bool finished = false;                      // Queda una serpiente (o ninguna)
+    int winner = NONE;                          // Id de la ganadora (NONE si murieron todas)
+    unsigned seed = 0;
+
+    // ========== CONSTRUCTOR ==========
+    // Las tablas por celda van en el heap (en tableros grandes ocupan
+    // cientos de KB) y se reservan una sola vez: tick() no reserva memoria
+    BasicArena(int botCount, int players, unsigned seed)
+        : snakes(std::min(botCount + std::min(players, MAX_PLAYERS), MAX_SNAKES)),
+          cells(CELL_COUNT), owner(CELL_COUNT), towardHead(CELL_COUNT, NONE),
+          claimTick(CELL_COUNT), claimer(CELL_COUNT), appleSlot(CELL_COUNT, NONE) {
+        playerCount = std::min(players, MAX_PLAYERS);
+        apples.reserve(CELL_COUNT);
+        obstacles.reserve(CELL_COUNT);
+        boardVertices.resize(CELL_COUNT * 6);
+        boardVertices.clear();
+        buildPanel();
+        reset(seed);
+    }
+
+    // Nueva ronda con las mismas serpientes (sin reservar memoria)
+    void reset(unsigned newSeed) {
+        seed = newSeed;
+        rngState = seed ? seed : 0x9E3779B9u;
+        std::fill(cells.begin(), cells.end(), CELL_EMPTY);
+        occupancy.clear();
+        std::fill(claimTick.begin(), claimTick.end(), 0u);
+        std::fill(appleSlot.begin(), appleSlot.end(), NONE);
+        apples.clear();
+        obstacles.clear();
+        tickCount = 0;
+        finished = false;
+        winner = NONE;
+
+        // Obstáculos sueltos (1% del tablero)
+        for (int i = 0; i < CELL_COUNT / 100; i++) {
+            int cell = randomInt(CELL_COUNT);
+            if (cells[cell] != CELL_EMPTY) continue;
+            setCell(cell, CELL_OBSTACLE);
+            obstacles.push_back(cell);
+        }
+
+        // Serpientes: primero los jugadores, después los bots
+        aliveCount = 0;
+        for (int id = 0; id < (int)snakes.size(); id++) {
+            ArenaSnake& s = snakes[id];
+            s = ArenaSnake();
+            s.player = id < playerCount;
+            s.rngState = (seed ^ (0x9E3779B9u * (id + 1))) | 1u;
+            if (placeSnake(id)) aliveCount++;
+        }
+        spawnApples(CELL_COUNT);
+    }
+
+    // Manzana en una celda vacía. Para escenarios de prueba que arman el
+    // tablero escribiendo 'cells': deja 'apples' y su índice de acuerdo
+    void placeApple(int cell) {
+        if (cells[cell] == CELL_EMPTY) addApple(cell);
+    }
+
+    // ========== ENTRADA ==========
+    // Dirección de un jugador (no se permite girar 180°)
+    void steerPlayer(int player, int dir) {
+        if (player >= playerCount) return;
+        ArenaSnake& s = snakes[player];
+        if (s.alive && dir != (s.direction + 2) % 4) s.nextDirection = dir;
+    }
+
+    // Flechas para el jugador 1, WASD para el jugador 2
+    void handleInput(sf::Keyboard::Scancode key) {
+        if (key == sf::Keyboard::Scan::Up) steerPlayer(0, 0);
+        else if (key == sf::Keyboard::Scan::Right) steerPlayer(0, 1);
+        else if (key == sf::Keyboard::Scan::Down) steerPlayer(0, 2);
+        else if (key == sf::Keyboard::Scan::Left) steerPlayer(0, 3);
+        else if (key == sf::Keyboard::Scan::W) steerPlayer(1, 0);
+        else if (key == sf::Keyboard::Scan::D) steerPlayer(1, 1);
+        else if (key == sf::Keyboard::Scan::S) steerPlayer(1, 2);
+        else if (key == sf::Keyboard::Scan::A) steerPlayer(1, 3);
+    }
+
+    // ========== TICK ==========
+    // Un movimiento de todas las serpientes vivas. Con 'pool' la fase de
+    // planificación se reparte entre sus hilos (mismo resultado).
+    void tick(WorkerPool* pool = nullptr) {
+        if (finished) return;
+        tickCount++;
+
+        // 1. Planificar (solo lee el tablero)
+        auto plan = [this](int begin, int end) {
+            for (int id = begin; id < end; id++) {
+                if (snakes[id].alive) planMove(snakes[id]);
+            }
+        };
+        if (pool) pool->parallelFor(static_cast<int>(snakes.size()), 32, plan);
+        else plan(0, static_cast<int>(snakes.size()));
+
+        // 2. Resolver conflictos contra la ocupación del tick anterior
+        for (ArenaSnake& s : snakes) {
+            if (!s.alive) continue;
+            s.dies = false;
+            s.grows = s.target != NONE && cells[s.target] == CELL_APPLE;
+        }
+        for (int id = 0; id < (int)snakes.size(); id++) {
+            ArenaSnake& s = snakes[id];
+            if (!s.alive) continue;
+            int target = s.target;
+            if (target == NONE || cells[target] == CELL_OBSTACLE) {
+                s.dies = true;
+                continue;
+            }
+            if (cells[target] == CELL_SNAKE) {
+                const ArenaSnake& other = snakes[owner[target]];
+                if (target != other.tail || other.grows) {
+                    s.dies = true;
+                    continue;
+                }
+            }
+            // Dos cabezas en la misma celda: mueren las dos
+            if (claimTick[target] == tickCount) {
+                s.dies = true;
+                snakes[claimer[target]].dies = true;
+            } else {
+                claimTick[target] = tickCount;
+                claimer[target] = id;
+            }
+        }
+
+        // 3. Aplicar: colas, cabezas y muertes (en ese orden)
+        for (ArenaSnake& s : snakes) {
+            if (!s.alive || s.dies || s.grows) continue;
+            int oldTail = s.tail;
+            s.tail = towardHead[oldTail];
+            setCell(oldTail, CELL_EMPTY);
+        }
+        for (int id = 0; id < (int)snakes.size(); id++) {
+            ArenaSnake& s = snakes[id];
+            if (!s.alive || s.dies) continue;
+            if (s.grows) {
+                removeApple(s.target);
+                s.length++;
+                s.applesEaten++;
+            }
+            setCell(s.target, CELL_SNAKE);
+            owner[s.target] = static_cast<unsigned short>(id);
+            towardHead[s.head] = s.target;
+            s.head = s.target;
+            s.direction = s.nextDirection;
+        }
+        for (int id = 0; id < (int)snakes.size(); id++) {
+            if (snakes[id].alive && snakes[id].dies) kill(id);
+        }
+
+        spawnApples(8);
+
+        // Fin de la ronda: queda una serpiente (si había rivales) o ninguna
+        if (aliveCount == 0 || (aliveCount == 1 && snakes.size() > 1)) {
+            finished = true;
+            winner = NONE;
+            for (int id = 0; id < (int)snakes.size(); id++) {
+                if (snakes[id].alive) winner = id;
+            }
+        }
+    }
+
+    // Serpiente viva más larga (NONE si no hay)
+    int leader() const {
+        int best = NONE;
+        for (int id = 0; id < (int)snakes.size(); id++) {
+            if (snakes[id].alive && (best == NONE || snakes[id].length > snakes[best].length)) best = id;
+        }
+        return best;
+    }
+
+    // ========== DIBUJO ==========
+    void draw(Renderer& renderer) {
+        float cellW = WINDOW_WIDTH * SCALE_X / COLS;
+        float cellH = WINDOW_HEIGHT * SCALE_Y / ROWS;
+        float gapX = cellW / GRID_SIZE;
+        float gapY = cellH / GRID_SIZE;
+        boardVertices.clear();
+
+        for (int cell : obstacles) appendCell(cell, cellW, cellH, gapX, gapY, sf::Color::Cyan);
+        for (int cell : apples) appendCell(cell, cellW, cellH, gapX, gapY, sf::Color::Red);
+        // Cada cuerpo se recorre de la cola a la cabeza por los enlaces
+        for (int id = 0; id < (int)snakes.size(); id++) {
+            const ArenaSnake& s = snakes[id];
+            if (!s.alive) continue;
+            sf::Color color = snakeColor(id);
+            int cell = s.tail;
+            for (int i = 1; i < s.length; i++) {
+                appendCell(cell, cellW, cellH, gapX, gapY, color);
+                cell = towardHead[cell];
+            }
+            appendCell(s.head, cellW, cellH, gapX, gapY, sf::Color::White);
+        }
+
+        if (boardVertices.getVertexCount() > 0) {
+            renderer.drawQuads(&boardVertices[0], boardVertices.getVertexCount());
+        }
+        renderer.fillRect(WINDOW_WIDTH * SCALE_X, 0, 2, WINDOW_HEIGHT * SCALE_Y, sf::Color::White);
+    }
+
+    // Tablero como textura de un texel por celda (--render=grid): con
+    // cientos de serpientes es un quad en lugar de miles
+    void drawGrid(Renderer& renderer, BoardTexture& board) {
+        float cellW = WINDOW_WIDTH * SCALE_X / COLS;
+        float cellH = WINDOW_HEIGHT * SCALE_Y / ROWS;
+
+        board.sync([this](int cell) {
+            switch (cells[cell]) {
+                case CELL_SNAKE: {
+                    int id = owner[cell];
+                    return snakes[id].head == cell ? sf::Color::White : snakeColor(id);
+                }
+                case CELL_APPLE:    return sf::Color::Red;
+                case CELL_OBSTACLE: return sf::Color::Cyan;
+                default:            return sf::Color::Transparent;
+            }
+        });
+        board.draw(renderer, 0, 0, cellW, cellH, cellW / GRID_SIZE, cellH / GRID_SIZE);
+        renderer.fillRect(WINDOW_WIDTH * SCALE_X, 0, 2, WINDOW_HEIGHT * SCALE_Y, sf::Color::White);
+    }
+
+    void drawUI(Renderer& renderer) {
+        float panelStartX = WINDOW_WIDTH * SCALE_X;
+        float panelX = panelStartX + 15;
+        float panelW = PANEL_WIDTH - 20;
+        char text[HudBatch::MAX_TEXT + 1];
+
+        hud.setRect(ui.panel, panelStartX + 5, 0, PANEL_WIDTH - 10, WINDOW_HEIGHT * SCALE_Y, sf::Color(0, 0, 0, 200));
+        float yPos = 10;
+
+        hud.setRect(ui.titleBg, panelX, yPos, panelW, 25, sf::Color(50, 50, 50));
+        hud.setText(ui.title, "ARENA", panelX + 6, yPos + 5, 2, sf::Color(200, 200, 200));
+        std::snprintf(text, sizeof(text), "%d/%d", aliveCount, (int)snakes.size());
+        setValueText(ui.alive, text, panelX + panelW - 6, yPos + 5, sf::Color::White);
+        yPos += 35;
+
+        for (int p = 0; p < MAX_PLAYERS; p++) {
+            if (p >= playerCount) {
+                hud.hide(ui.players[p].label);
+                hud.hide(ui.players[p].value);
+                continue;
+            }
+            const ArenaSnake& s = snakes[p];
+            std::snprintf(text, sizeof(text), "P%d", p + 1);
+            hud.setText(ui.players[p].label, text, panelX + 6, yPos, 2, snakeColor(p));
+            if (s.alive) std::snprintf(text, sizeof(text), "LEN %d", s.length);
+            else std::snprintf(text, sizeof(text), "OUT");
+            setValueText(ui.players[p].value, text, panelX + panelW - 6, yPos, s.alive ? sf::Color::White : sf::Color::Red);
+            yPos += 22;
+        }
+
+        int top = leader();
+        hud.setRect(ui.leaderLine, panelX, yPos, panelW, 3, sf::Color::Yellow);
+        hud.setText(ui.leaderLabel, "TOP", panelX + 6, yPos + 9, 2, sf::Color::Yellow);
+        if (top != NONE) std::snprintf(text, sizeof(text), "LEN %d", snakes[top].length);
+        else std::snprintf(text, sizeof(text), "-");
+        setValueText(ui.leaderValue, text, panelX + panelW - 6, yPos + 9, sf::Color::Yellow);
+        yPos += 35;
+
+        if (finished) {
+            if (winner == NONE) std::snprintf(text, sizeof(text), "DRAW");
+            else if (snakes[winner].player) std::snprintf(text, sizeof(text), "WINNER P%d", winner + 1);
+            else std::snprintf(text, sizeof(text), "WINNER BOT %d", winner);
+            hud.setText(ui.result, text, panelX + 6, yPos, 2, sf::Color::Green);
+            hud.setText(ui.restart, "ENTER: AGAIN", panelX + 6, yPos + 22, 2, sf::Color::White);
+        } else {
+            hud.hide(ui.result);
+            hud.hide(ui.restart);
+        }
+
+        // Minimapa al pie del panel: solo se recolorean los bloques que cambiaron
+        minimap.sync(occupancy);
+        sf::Vector2f mapSize = minimap.size(panelW);
+        float mapY = WINDOW_HEIGHT * SCALE_Y - mapSize.y - 12;
+        hud.setText(ui.minimapLabel, "MAP", panelX, mapY - 20, 2, sf::Color(200, 200, 200));
+        hud.setFrame(ui.minimapFrame, panelX - 2, mapY - 2, mapSize.x + 4, mapSize.y + 4, 2, sf::Color(200, 200, 200));
+
+        hud.draw(renderer);
+        minimap.draw(renderer, panelX, mapY, panelW);
+    }
+
+    // Color de cada serpiente: jugadores fijos, bots de una paleta
+    sf::Color snakeColor(int id) const {
+        static const sf::Color PLAYERS[MAX_PLAYERS] = {sf::Color::Green, sf::Color::Yellow};
+        static const sf::Color BOTS[] = {
+            sf::Color(60, 120, 255), sf::Color(200, 80, 200), sf::Color(255, 140, 40), sf::Color(120, 200, 120),
+            sf::Color(160, 110, 70), sf::Color(90, 200, 220), sf::Color(230, 230, 120), sf::Color(150, 150, 255),
+        };
+        if (snakes[id].player) return PLAYERS[id];
+        return BOTS[id % (sizeof(BOTS) / sizeof(BOTS[0]))];
+    }
+
+private:
+    // ========== CONFLICTOS ==========
+    std::vector<unsigned> claimTick;            // Tick en que se reclamó cada celda
+    std::vector<int> claimer;                   // Primera serpiente que la reclamó
+    std::vector<int> appleSlot;                 // Posición de cada manzana en 'apples'
+    unsigned rngState = 0;                      // Generador de la arena (spawns)
+
+    // ========== DIBUJO ==========
+    sf::VertexArray boardVertices{sf::Triangles};
+    struct PlayerSlots { int label, value; };
+    struct PanelSlots {
+        int panel, titleBg, title, alive;
+        PlayerSlots players[MAX_PLAYERS];
+        int leaderLine, leaderLabel, leaderValue;
+        int result, restart;
+        int minimapLabel, minimapFrame;
+    };
+    HudBatch hud;
+    PanelSlots ui{};
+    Minimap minimap;
+
+    int randomInt(int max) {
+        rngState ^= rngState << 13;
+        rngState ^= rngState >> 17;
+        rngState ^= rngState << 5;
+        return static_cast<int>(rngState % static_cast<unsigned>(max));
+    }
+
+    static int botRandom(ArenaSnake& s) {
+        s.rngState ^= s.rngState << 13;
+        s.rngState ^= s.rngState >> 17;
+        s.rngState ^= s.rngState << 5;
+        return static_cast<int>(s.rngState >> 8);
+    }
+
+    // Celda vecina en una dirección (NONE si sale del tablero)
+    static int neighbor(int cell, int dir) {
+        int x = cell % COLS, y = cell / COLS;
+        if (dir == 0) y--;
+        else if (dir == 1) x++;
+        else if (dir == 2) y++;
+        else x--;
+        if (static_cast<unsigned>(x) >= static_cast<unsigned>(COLS) ||
+            static_cast<unsigned>(y) >= static_cast<unsigned>(ROWS)) return NONE;
+        return cellIndex(x, y);
+    }
+
+    // Se puede entrar (sin saber aún qué harán las demás): vacía,
+    // manzana o la cola de una serpiente
+    bool passable(int cell) const {
+        unsigned char c = cells[cell];
+        if (c == CELL_EMPTY || c == CELL_APPLE) return true;
+        return c == CELL_SNAKE && snakes[owner[cell]].tail == cell;
+    }
+
+    // Celdas libres alcanzables desde 'start', hasta LIMIT. Las visitadas
+    // se marcan en una ventana local centrada en 'start' (ninguna queda a
+    // más de LIMIT - 1 celdas), así no se escribe nada compartido.
+    int freeSpace(int start) const {
+        static constexpr int LIMIT = 20;
+        static constexpr int RADIUS = LIMIT - 1;
+        std::uint64_t seen[2 * RADIUS + 1] = {};   // Bit (dx + RADIUS) de la fila dy + RADIUS
+        int queue[LIMIT];
+        int startX = start % COLS, startY = start / COLS;
+        int count = 0, next = 0;
+        queue[count++] = start;
+        seen[RADIUS] |= std::uint64_t(1) << RADIUS;
+        while (next < count && count < LIMIT) {
+            int cell = queue[next++];
+            for (int dir = 0; dir < 4 && count < LIMIT; dir++) {
+                int n = neighbor(cell, dir);
+                if (n == NONE || !passable(n)) continue;
+                int row = n / COLS - startY + RADIUS;
+                std::uint64_t bit = std::uint64_t(1) << (n % COLS - startX + RADIUS);
+                if (seen[row] & bit) continue;
+                seen[row] |= bit;
+                queue[count++] = n;
+            }
+        }
+        return count;
+    }
+
+    // Verdadero si otra cabeza podría entrar a 'cell' en este mismo tick
+    bool nearOtherHead(int cell, int ownHead) const {
+        for (int dir = 0; dir < 4; dir++) {
+            int n = neighbor(cell, dir);
+            if (n != NONE && n != ownHead && cells[n] == CELL_SNAKE && snakes[owner[n]].head == n) return true;
+        }
+        return false;
+    }
+
+    // ========== FASE 1: PLANIFICAR ==========
+    // Solo escribe en 's'. El bot evalúa girar a la izquierda, seguir o
+    // girar a la derecha: espacio libre cercano, manzanas en línea recta,
+    // cabezas rivales cerca y un poco de azar para desempatar.
+    void planMove(ArenaSnake& s) const {
+        if (!s.player) {
+            int bestScore = INT_MIN;
+            int bestDir = s.direction;
+            for (int turn = 3; turn <= 5; turn++) {
+                int dir = (s.direction + turn) % 4;
+                int n = neighbor(s.head, dir);
+                if (n == NONE || !passable(n)) continue;
+                int score = freeSpace(n) * 4;
+                int cell = n;
+                for (int distance = 0; distance < 10 && cell != NONE; distance++) {
+                    if (cells[cell] == CELL_APPLE) {
+                        score += (10 - distance) * 6;
+                        break;
+                    }
+                    if (distance > 0 && !passable(cell)) break;
+                    cell = neighbor(cell, dir);
+                }
+                if (nearOtherHead(n, s.head)) score -= 40;   // Posible choque de cabezas
+                if (dir == s.direction) score += 2;
+                score += botRandom(s) & 3;
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestDir = dir;
+                }
+            }
+            s.nextDirection = bestDir;
+        }
+        s.target = neighbor(s.head, s.nextDirection);
+    }
+
+    // ========== CREACIÓN Y MUERTE ==========
+    // Coloca una serpiente recta de START_LENGTH celdas libres
+    bool placeSnake(int id) {
+        ArenaSnake& s = snakes[id];
+        for (int attempt = 0; attempt < 64; attempt++) {
+            int dir = randomInt(4);
+            int head = randomInt(CELL_COUNT);
+            int body[START_LENGTH];
+            int cell = head;
+            int placed = 0;
+            for (; placed < START_LENGTH && cell != NONE && cells[cell] == CELL_EMPTY; placed++) {
+                body[placed] = cell;
+                cell = neighbor(cell, (dir + 2) % 4);
+            }
+            // Necesita las celdas del cuerpo y espacio delante
+            int ahead = neighbor(head, dir);
+            if (placed < START_LENGTH || ahead == NONE || cells[ahead] != CELL_EMPTY) continue;
+            for (int i = 0; i < START_LENGTH; i++) {
+                setCell(body[i], CELL_SNAKE);
+                owner[body[i]] = static_cast<unsigned short>(id);
+                towardHead[body[i]] = i == 0 ? NONE : body[i - 1];
+            }
+            s.head = body[0];
+            s.tail = body[START_LENGTH - 1];
+            s.length = START_LENGTH;
+            s.direction = s.nextDirection = dir;
+            s.alive = true;
+            return true;
+        }
+        return false;
+    }
+
+    // Retira el cuerpo; uno de cada dos segmentos queda como manzana.
+    // Una celda que ya tomó otra cabeza en este tick no se toca.
+    void kill(int id) {
+        ArenaSnake& s = snakes[id];
+        int cell = s.tail;
+        for (int i = 0; i < s.length; i++) {
+            int next = towardHead[cell];
+            if (cells[cell] == CELL_SNAKE && owner[cell] == id) {
+                setCell(cell, CELL_EMPTY);
+                if (i % 2 == 0) addApple(cell);
+            }
+            cell = next;
+        }
+        s.alive = false;
+        aliveCount--;
+    }
+
+    // ========== MANZANAS ==========
+    void addApple(int cell) {
+        setCell(cell, CELL_APPLE);
+        appleSlot[cell] = static_cast<int>(apples.size());
+        apples.push_back(cell);
+    }
+
+    void removeApple(int cell) {
+        int slot = appleSlot[cell];
+        int last = apples.back();
+        apples[slot] = last;
+        appleSlot[last] = slot;
+        apples.pop_back();
+        appleSlot[cell] = NONE;
+    }
+
+    // Hasta 'maxNew' manzanas nuevas mientras haya menos de 1 cada 40 celdas
+    void spawnApples(int maxNew) {
+        for (int i = 0; i < maxNew && (int)apples.size() < CELL_COUNT / 40; i++) {
+            int cell = randomInt(CELL_COUNT);
+            if (cells[cell] == CELL_EMPTY) addApple(cell);
+        }
+    }
+
+    // ========== PANEL ==========
+    void buildPanel() {
+        ui.panel = hud.addRect();
+        ui.titleBg = hud.addRect();
+        ui.title = hud.addText(5);
+        ui.alive = hud.addText(9);
+        for (PlayerSlots& row : ui.players) {
+            row.label = hud.addText(2);
+            row.value = hud.addText(8);
+        }
+        ui.leaderLine = hud.addRect();
+        ui.leaderLabel = hud.addText(3);
+        ui.leaderValue = hud.addText(8);
+        ui.result = hud.addText(16);
+        ui.restart = hud.addText(12);
+        ui.minimapLabel = hud.addText(3);
+        ui.minimapFrame = hud.addFrame();
+    }
+
+    // Escribe una celda y la cuenta en la pirámide del minimapa
+    void setCell(int cell, unsigned char type) {
+        occupancy.change(cell % COLS, cell / COLS, minimapLayer(cells[cell]), minimapLayer(type));
+        cells[cell] = type;
+    }
+
+    void setValueText(int slot, const char* text, float rightX, float y, sf::Color color) {
+        hud.setText(slot, text, rightX - HudBatch::textWidth(std::strlen(text), 2), y, 2, color);
+    }
+
+    // Agrega una celda (dos triángulos) al lote del tablero
+    void appendCell(int cell, float cellW, float cellH, float gapX, float gapY, sf::Color color) {
+        int x = cell % COLS, y = cell / COLS;
+        float left = x * cellW + gapX;
+        float top = y * cellH + gapY;
+        float right = (x + 1) * cellW - gapX;
+        float bottom = (y + 1) * cellH - gapY;
+        boardVertices.append(sf::Vertex(sf::Vector2f(left, top), color));
+        boardVertices.append(sf::Vertex(sf::Vector2f(right, top), color));
+        boardVertices.append(sf::Vertex(sf::Vector2f(right, bottom), color));
+        boardVertices.append(sf::Vertex(sf::Vector2f(left, top), color));
+        boardVertices.append(sf::Vertex(sf::Vector2f(right, bottom), color));
+        boardVertices.append(sf::Vertex(sf::Vector2f(left, bottom), color));
+    }
+};
+
+// ========== PRESETS DE ARENA ==========
+using Arena = BasicArena<160, 120>;             // 19200 celdas: cientos de serpientes
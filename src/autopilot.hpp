@@ -0,0 +1,77 @@
+// ============================================================
+// SNAKE vs BLOCKS - Piloto automático
+// ============================================================
+// Elige la dirección de la serpiente sin intervención del jugador, para
+// las herramientas sin ventana (soak) y las demostraciones.
+//
+// - Descarta las direcciones que chocan en el próximo paso (pared sin
+//   WALL_PASS, cuerpo, obstáculo) y las que entran a una celda sin salida.
+// - Entre las que quedan, va hacia la manzana más cercana (o un power-up
+//   si no hay manzanas).
+// - No reserva memoria ni modifica el juego: solo lee el estado.
+// ============================================================
+#pragma once
+
+#include "game_state.hpp"     // BasicGameState, CellType
+#include <cstdlib>            // abs
+
+// Dirección (0=arriba, 1=derecha, 2=abajo, 3=izquierda) para el próximo
+// movimiento; si todas chocan devuelve la actual
+template <class Game>
+int autopilotDirection(const Game& game) {
+    static const int DX[4] = {0, 1, 0, -1};
+    static const int DY[4] = {-1, 0, 1, 0};
+    const SnakeSegment& head = game.snake[0];
+
+    // Celda a la que lleva un paso desde (x, y); false si es pared
+    auto step = [&game](int x, int y, int dir, int& nx, int& ny) {
+        nx = x + DX[dir];
+        ny = y + DY[dir];
+        if (Game::inBounds(nx, ny)) return true;
+        if (!game.wallPassActive) return false;
+        nx = Game::wrapX(nx);
+        ny = Game::wrapY(ny);
+        return true;
+    };
+    auto blocked = [&game](int x, int y) {
+        unsigned char cell = game.cells[Game::cellIndex(x, y)];
+        return cell == CELL_SNAKE || cell == CELL_OBSTACLE;
+    };
+
+    // Objetivo: la manzana más cercana, si no un power-up, si no nada
+    int targetX = -1, targetY = -1, bestDistance = 0;
+    auto consider = [&](int x, int y) {
+        int distance = std::abs(x - head.x) + std::abs(y - head.y);
+        if (targetX < 0 || distance < bestDistance) {
+            targetX = x;
+            targetY = y;
+            bestDistance = distance;
+        }
+    };
+    for (const Block& block : game.blocks) consider(block.x, block.y);
+    if (targetX < 0) {
+        for (const PowerUp& powerUp : game.powerUps) consider(powerUp.x, powerUp.y);
+    }
+
+    int best = game.direction;
+    int bestScore = -1000000;
+    for (int dir = 0; dir < 4; dir++) {
+        if (game.snake.size() > 1 && dir == (game.direction + 2) % 4) continue;  // Volver sobre sí misma
+        int nx, ny;
+        if (!step(head.x, head.y, dir, nx, ny) || blocked(nx, ny)) continue;
+
+        // Salidas libres desde la celda nueva (la cabeza actual ya es cuerpo)
+        int exits = 0;
+        for (int next = 0; next < 4; next++) {
+            int ex, ey;
+            if (step(nx, ny, next, ex, ey) && !blocked(ex, ey) && !(ex == head.x && ey == head.y)) exits++;
+        }
+        int score = exits == 0 ? -10000 : exits * 2;
+        if (targetX >= 0) score -= 4 * (std::abs(targetX - nx) + std::abs(targetY - ny));
+        if (score > bestScore) {
+            bestScore = score;
+            best = dir;
+        }
+    }
+    return best;
+}
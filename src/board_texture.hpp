@@ -0,0 +1,114 @@
+// ============================================================
+// SNAKE vs BLOCKS - Tablero como textura (un texel por celda)
+// ============================================================
+// Modo de dibujo alternativo (--render=grid): el color de cada celda
+// se guarda en una imagen del tamaño del tablero y el tablero entero es
+// un solo quad escalado con muestreo del texel más cercano.
+//
+// - sync() compara cada celda con el frame anterior y solo cambia (y
+//   sube a la GPU) los texels distintos; las vacías son transparentes.
+// - El separador de 1 píxel entre celdas son líneas fijas del color
+//   de fondo encima del quad: una por columna y una por fila, creadas
+//   una sola vez para la geometría actual.
+//
+// El costo no depende de cuántas entidades haya, solo del tamaño del
+// tablero, y el resultado es idéntico píxel a píxel al modo normal.
+// ============================================================
+#pragma once
+
+#include "renderer.hpp"       // Renderer y Picture
+#include <cstdint>            // uint32_t
+#include <vector>
+
+class BoardTexture {
+public:
+    // ========== CONSTRUCTOR ==========
+    BoardTexture(int cols, int rows)
+        : cols(cols), rows(rows), current(static_cast<std::size_t>(cols) * rows, 0),
+          gapVertices(sf::Triangles, static_cast<std::size_t>(cols + rows + 2) * 6) {
+        picture.create(cols, rows, sf::Color::Transparent);
+    }
+
+    // ========== SINCRONIZAR ==========
+    // colorOf(índice de celda) da el color de cada celda; solo se
+    // escriben las que cambiaron desde la última llamada
+    template <class ColorOf>
+    void sync(ColorOf colorOf) {
+        changedTexels = 0;
+        for (int y = 0; y < rows; y++) {
+            for (int x = 0; x < cols; x++) {
+                int index = y * cols + x;
+                sf::Color color = colorOf(index);
+                std::uint32_t packed = color.toInteger();
+                if (current[index] == packed) continue;
+                current[index] = packed;
+                picture.setPixel(x, y, color);
+                changedTexels++;
+            }
+        }
+    }
+
+    // Texels que cambiaron en la última sincronización
+    int changed() const { return changedTexels; }
+
+    // ========== DIBUJO ==========
+    // Tablero en (x, y) con celdas de cellW x cellH y 'gap' píxeles
+    // de separación a cada lado de cada celda
+    void draw(Renderer& renderer, float x, float y, float cellW, float cellH, float gapX, float gapY,
+              sf::Color background = sf::Color::Black) {
+        float width = cols * cellW, height = rows * cellH;
+        writeQuad(board, x, y, width, height, sf::Color::White, 0, 0, float(cols), float(rows));
+        renderer.drawQuads(board, 6, &picture);
+
+        if (cellW != lastCellW || cellH != lastCellH || gapX != lastGapX || gapY != lastGapY ||
+            x != lastX || y != lastY || background != lastBackground) {
+            buildGaps(x, y, cellW, cellH, gapX, gapY, background);
+        }
+        if (gapVertices.getVertexCount() > 0) {
+            renderer.drawQuads(&gapVertices[0], gapVertices.getVertexCount());
+        }
+    }
+
+private:
+    int cols, rows;
+    Picture picture;                        // Un texel por celda
+    std::vector<std::uint32_t> current;     // Color ya escrito en cada texel
+    int changedTexels = 0;
+    sf::Vertex board[6];                    // Quad del tablero
+    sf::VertexArray gapVertices;            // Líneas de separación
+    float lastX = -1, lastY = -1, lastCellW = -1, lastCellH = -1, lastGapX = -1, lastGapY = -1;
+    sf::Color lastBackground;
+
+    static void writeQuad(sf::Vertex* quad, float x, float y, float w, float h, sf::Color color,
+                          float u0 = 0, float v0 = 0, float u1 = 0, float v1 = 0) {
+        quad[0] = sf::Vertex(sf::Vector2f(x, y), color, sf::Vector2f(u0, v0));
+        quad[1] = sf::Vertex(sf::Vector2f(x + w, y), color, sf::Vector2f(u1, v0));
+        quad[2] = sf::Vertex(sf::Vector2f(x + w, y + h), color, sf::Vector2f(u1, v1));
+        quad[3] = sf::Vertex(sf::Vector2f(x, y), color, sf::Vector2f(u0, v0));
+        quad[4] = sf::Vertex(sf::Vector2f(x + w, y + h), color, sf::Vector2f(u1, v1));
+        quad[5] = sf::Vertex(sf::Vector2f(x, y + h), color, sf::Vector2f(u0, v1));
+    }
+
+    // Una línea vertical por cada borde entre columnas (y los dos
+    // extremos) y lo mismo para las filas. Los extremos quedan con las
+    // mismas coordenadas que usa appendCell: x * cellW ± gap.
+    void buildGaps(float x, float y, float cellW, float cellH, float gapX, float gapY, sf::Color background) {
+        lastX = x; lastY = y; lastCellW = cellW; lastCellH = cellH; lastGapX = gapX; lastGapY = gapY;
+        lastBackground = background;
+        gapVertices.clear();
+        float width = cols * cellW, height = rows * cellH;
+        sf::Vertex quad[6];
+        for (int c = 0; c <= cols; c++) {
+            float left = c == 0 ? x : x + (c * cellW - gapX);
+            float right = c == cols ? x + width : x + (c * cellW + gapX);
+            writeQuad(quad, left, y, right - left, height, background);
+            for (const sf::Vertex& v : quad) gapVertices.append(v);
+        }
+        for (int r = 0; r <= rows; r++) {
+            float top = r == 0 ? y : y + (r * cellH - gapY);
+            float bottom = r == rows ? y + height : y + (r * cellH + gapY);
+            writeQuad(quad, x, top, width, bottom - top, background);
+            for (const sf::Vertex& v : quad) gapVertices.append(v);
+        }
+    }
+};
@@ -0,0 +1,78 @@
+// ============================================================
+// SNAKE vs BLOCKS - Avance rápido (demostración y repeticiones)
+// ============================================================
+// Corre varios ticks de la simulación por cada frame mostrado (de 2x a
+// 100x) y deja que el bucle principal dibuje solo el último estado.
+//
+// Guardián de presupuesto: los ticks de un frame no pueden pasar de
+// TICK_BUDGET_SECONDS (lo que queda del frame de 60 fps es para dibujar).
+// Después de cada tick se estima si el siguiente todavía entra; si no,
+// el frame se corta ahí y el multiplicador baja a lo que entró. Cuando
+// los frames vuelven a sobrar, sube de a poco hasta el elegido.
+// ============================================================
+#pragma once
+
+#include <algorithm>          // min, max
+#include <chrono>             // Reloj por defecto
+
+class FastForward {
+public:
+    static constexpr int LEVELS[] = {1, 2, 5, 10, 20, 50, 100};    // Multiplicadores de +/-
+    static constexpr int LEVEL_COUNT = sizeof(LEVELS) / sizeof(LEVELS[0]);
+    static constexpr double TICK_BUDGET_SECONDS = 0.010;            // De los 16.6 ms del frame
+
+    explicit FastForward(double tickBudgetSeconds = TICK_BUDGET_SECONDS) : budget(tickBudgetSeconds) {}
+
+    // ========== MULTIPLICADOR ==========
+    void faster() { setLevel(level + 1); }
+    void slower() { setLevel(level - 1); }
+
+    void setLevel(int index) {
+        level = std::max(0, std::min(LEVEL_COUNT - 1, index));
+        current = LEVELS[level];
+    }
+
+    int requested() const { return LEVELS[level]; }             // El que eligió el jugador
+    int effective() const { return current; }                   // El que entra en el presupuesto
+    bool limited() const { return current < LEVELS[level]; }
+
+    // ========== UN FRAME ==========
+    // Llama a step() hasta effective() veces; step() corre un tick y
+    // devuelve false si ya no hay nada que correr (fin de la partida o de
+    // la repetición). now() da el tiempo en segundos. Devuelve los ticks
+    // que se corrieron.
+    template <class Step, class Now>
+    int run(Step step, Now now) {
+        double start = now();
+        int ticks = 0;
+        while (ticks < current) {
+            if (!step()) return ticks;
+            ticks++;
+            if (ticks == current) break;
+            // El próximo tick costaría como el promedio de los anteriores
+            double elapsed = now() - start;
+            if (elapsed * (ticks + 1) / ticks > budget) {
+                current = ticks;
+                return ticks;
+            }
+        }
+        // Frame completo: subir un cuarto si el nuevo valor también entraría
+        if (current < requested()) {
+            int next = std::min(requested(), current + std::max(1, current / 4));
+            if ((now() - start) * next / current <= budget) current = next;
+        }
+        return ticks;
+    }
+
+    template <class Step>
+    int run(Step step) {
+        return run(step, [] {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        });
+    }
+
+private:
+    double budget;
+    int level = 0;          // Índice en LEVELS
+    int current = 1;        // Ticks por frame ahora
+};
@@ -0,0 +1,78 @@
+// ============================================================
+// SNAKE vs BLOCKS - Arena de memoria por frame
+// ============================================================
+// Memoria temporal para cálculos de un solo frame/tick. Se reserva
+// una vez y se "libera" entera con reset(), sin llamar a new/delete
+// en cada frame.
+// ============================================================
+#pragma once
+
+#include <cstddef>            // size_t
+#include <memory>             // unique_ptr
+#include <new>                // Placement new
+#include <vector>             // Bloques de desborde
+
+class FrameArena {
+public:
+    // ========== CONSTRUCTOR ==========
+    explicit FrameArena(std::size_t capacity = 16 * 1024)
+        : buffer(new unsigned char[capacity]), capacity(capacity) {}
+
+    // Al copiar se reserva la misma capacidad; el contenido es temporal y no se copia
+    FrameArena(const FrameArena& other) : FrameArena(other.capacity) {}
+    FrameArena& operator=(const FrameArena& other) {
+        if (this != &other && capacity < other.capacity) {
+            buffer.reset(new unsigned char[other.capacity]);
+            capacity = other.capacity;
+        }
+        used = 0;
+        return *this;
+    }
+    FrameArena(FrameArena&&) = default;
+    FrameArena& operator=(FrameArena&&) = default;
+
+    // ========== RESERVA ==========
+    // Devuelve espacio para 'count' objetos T (construidos por defecto).
+    // Si no cabe se usa un bloque de desborde y en el siguiente reset()
+    // el buffer principal crece para que no vuelva a pasar.
+    template <class T>
+    T* allocate(std::size_t count) {
+        std::size_t bytes = count * sizeof(T);
+        std::size_t start = (used + alignof(T) - 1) & ~(alignof(T) - 1);
+        unsigned char* memory;
+        if (start + bytes <= capacity) {
+            memory = buffer.get() + start;
+            used = start + bytes;
+        } else {
+            overflow.emplace_back(new unsigned char[bytes]);  // new[] ya alinea a max_align_t
+            overflowBytes += bytes;
+            memory = overflow.back().get();
+        }
+        T* items = reinterpret_cast<T*>(memory);
+        for (std::size_t i = 0; i < count; i++) new (items + i) T();
+        return items;
+    }
+
+    // ========== LIMPIEZA ==========
+    // Descarta todo lo reservado desde el último reset() (solo tipos triviales)
+    void reset() {
+        if (!overflow.empty()) {
+            std::size_t newCapacity = (capacity + overflowBytes) * 2;
+            overflow.clear();
+            overflowBytes = 0;
+            buffer.reset(new unsigned char[newCapacity]);
+            capacity = newCapacity;
+        }
+        used = 0;
+    }
+
+    std::size_t bytesUsed() const { return used; }
+    std::size_t bytesCapacity() const { return capacity; }
+
+private:
+    std::unique_ptr<unsigned char[]> buffer;                // Buffer principal
+    std::size_t capacity = 0;                               // Tamaño del buffer principal
+    std::size_t used = 0;                                   // Bytes usados desde el último reset()
+    std::vector<std::unique_ptr<unsigned char[]>> overflow; // Bloques que no cupieron
+    std::size_t overflowBytes = 0;                          // Total de bytes desbordados
+};
@@ -0,0 +1,1065 @@
+// ============================================================
+// SNAKE vs BLOCKS - Estado y simulación del juego
+// ============================================================
+// Tablero, entidades, reglas de movimiento/colisión y dibujo del
+// juego en curso. Lo comparten el ejecutable principal y las
+// herramientas (benchmarks).
+// ============================================================
+#pragma once
+
+// ============================================================
+// LIBRERÍAS INCLUIDAS
+// ============================================================
+#include <SFML/Graphics.hpp>  // Gráficos y renderizado
+#include <vector>             // Contenedor dinámico
+#include <cstdlib>            // rand() para la semilla por defecto
+#include <algorithm>          // min (tope de velocidad)
+#include <array>              // Grid de ocupación de tamaño fijo
+#include <cstdio>             // snprintf para los números del panel
+#include <cstring>            // strlen
+#include <utility>            // std::move
+#include "frame_arena.hpp"    // Memoria temporal por tick
+#include "hud_text.hpp"       // Texto del panel lateral (atlas de glifos)
+#include "obstacle_regions.hpp" // Obstáculos que no encierran zonas del tablero
+#include "renderer.hpp"       // Destino de dibujo (SFML o software)
+#include "board_texture.hpp"  // Tablero como textura (--render=grid)
+#include "minimap.hpp"        // Minimapa del panel (tableros grandes)
+#include "timer_wheel.hpp"    // Spawns y duración de power-ups
+
+// ============================================================
+// CONSTANTES DE CONFIGURACIÓN
+// ============================================================
+
+// Tamaño de cada celda del grid (en píxeles)
+const int GRID_SIZE = 20;
+
+// Resoluciones base (sin panel lateral)
+const int BASE_WINDOW_WIDTH = 800;
+const int BASE_WINDOW_HEIGHT = 600;
+
+// Ancho del panel lateral con información
+const int PANEL_WIDTH = 280;
+
+// ============================================================
+// VARIABLES GLOBALES DE PANTALLA
+// ============================================================
+
+// Dimensiones de la ventana de juego (cambian según resolución)
+inline int WINDOW_WIDTH = 800;
+inline int WINDOW_HEIGHT = 600;
+
+// Ancho total (juego + panel)
+inline int SCREEN_WIDTH = 1080;
+inline int SCREEN_HEIGHT = 720;
+
+// Factores de escala para adaptarse a diferentes resoluciones
+inline float SCALE_X = 1.0f;
+inline float SCALE_Y = 1.0f;
+
+// ============================================================
+// ENUMERACIONES - Tipos de power-ups
+// ============================================================
+
+// Tipos de power-ups disponibles
+enum PowerUpType {
+    WALL_PASS,           // Permite atravesar paredes (10s)
+    DOUBLE_SCORE,        // Duplica puntos (10s)
+    MAGNET,              // Atrae manzanas hacia la serpiente (10s)
+    OBSTACLE_DESTROYER,  // Destruye todos los obstáculos (instantáneo)
+    POWERUP_COUNT        // Cantidad de tipos (no es un power-up)
+};
+
+// Qué pasa al tomar un power-up que ya está activo
+enum StackRule {
+    STACK_REFRESH,       // La duración vuelve a empezar
+    STACK_EXTEND         // Se suma la duración a lo que quedaba
+};
+
+// Temporizadores de la partida (ids de la TimerWheel)
+enum GameTimer {
+    TIMER_APPLE_SPAWN,       // Próxima manzana
+    TIMER_POWERUP_SPAWN,     // Próximo power-up normal
+    TIMER_OBSTACLE_SPAWN,    // Próximo obstáculo
+    TIMER_DESTROYER_SPAWN,   // Próximo OBSTACLE_DESTROYER (solo con 15+ obstáculos)
+    TIMER_POWERUP_EXPIRE,    // Fin de cada power-up: TIMER_POWERUP_EXPIRE + PowerUpType
+    TIMER_COUNT = TIMER_POWERUP_EXPIRE + POWERUP_COUNT
+};
+
+// Duración de un tick de simulación (update se llama a 60 Hz)
+constexpr float TICK_SECONDS = 0.016f;
+
+// Causa del game over
+enum DeathCause {
+    DEATH_NONE,          // La partida sigue en curso
+    DEATH_WALL,          // Chocó con una pared
+    DEATH_SELF,          // Chocó con su propio cuerpo
+    DEATH_OBSTACLE       // Chocó con un obstáculo
+};
+
+// Eventos de un tick para los efectos visuales (partículas)
+enum GameEventType : unsigned char {
+    EVENT_APPLE_EATEN,          // La serpiente comió una manzana
+    EVENT_MAGNET_PICKUP,        // MAGNET atrajo una manzana hasta la cabeza
+    EVENT_POWERUP_TAKEN,        // Se tomó un power-up (detail = PowerUpType)
+    EVENT_OBSTACLE_DESTROYED,   // OBSTACLE_DESTROYER eliminó este obstáculo
+    EVENT_DEATH                 // Game over (en la posición de la cabeza)
+};
+
+struct GameEvent {
+    GameEventType type;
+    int x, y;                   // Celda del evento
+    int detail;                 // Dato extra según el tipo
+};
+
+// ============================================================
+// ESTRUCTURAS DE DATOS
+// ============================================================
+
+// Representa un segmento de la serpiente
+struct SnakeSegment {
+    int x, y;  // Posición en el grid
+    
+    SnakeSegment(int x = 0, int y = 0) : x(x), y(y) {}
+    
+    // Compara si dos segmentos están en la misma posición
+    bool operator==(const SnakeSegment& other) const {
+        return x == other.x && y == other.y;
+    }
+};
+
+// Representa una manzana/bloque para comer
+struct Block {
+    int x, y;           // Posición en el grid
+    
+    Block(int x, int y) : x(x), y(y) {}
+};
+
+// Representa un power-up especial
+struct PowerUp {
+    int x, y;           // Posición en el grid
+    PowerUpType type;   // Tipo de poder
+    
+    PowerUp(int x, int y, PowerUpType type) : x(x), y(y), type(type) {}
+};
+
+// Representa un obstáculo en el mapa
+struct Obstacle {
+    int x, y;           // Posición en el grid
+    
+    Obstacle(int x, int y) : x(x), y(y) {}
+};
+
+// Contenido de una celda del tablero (una sola entidad por celda)
+// Los power-ups ocupan CELL_POWERUP + PowerUpType para conservar su tipo
+enum CellType : unsigned char {
+    CELL_EMPTY = 0,      // Celda libre
+    CELL_SNAKE,          // Segmento de la serpiente
+    CELL_APPLE,          // Manzana
+    CELL_OBSTACLE,       // Obstáculo
+    CELL_POWERUP         // Primer valor de power-up (WALL_PASS)
+};
+
+// Celda que representa a un power-up del tipo indicado
+constexpr unsigned char powerUpCell(PowerUpType type) {
+    return static_cast<unsigned char>(CELL_POWERUP + type);
+}
+
+// Verdadero si la celda contiene cualquier power-up
+constexpr bool isPowerUpCell(unsigned char cell) {
+    return cell >= CELL_POWERUP;
+}
+
+// Capa del minimapa en la que cuenta una celda
+constexpr int minimapLayer(unsigned char cell) {
+    return cell == CELL_EMPTY      ? LAYER_NONE
+           : cell == CELL_SNAKE    ? LAYER_SNAKE
+           : cell == CELL_OBSTACLE ? LAYER_OBSTACLE
+           : cell == CELL_APPLE    ? LAYER_APPLE
+                                   : LAYER_POWERUP;
+}
+
+// ============================================================
+// FUNCIÓN DE CÁLCULO DE ESCALA
+// ============================================================
+
+// Calcula los factores de escala según la resolución de pantalla
+inline void calculateScaling() {
+    // Ancho total = ancho del juego + ancho del panel
+    SCREEN_WIDTH = WINDOW_WIDTH + PANEL_WIDTH;
+    SCREEN_HEIGHT = WINDOW_HEIGHT;
+    
+    // Factores de escala para adaptarse a diferentes resoluciones
+    SCALE_X = (float)WINDOW_WIDTH / BASE_WINDOW_WIDTH;
+    SCALE_Y = (float)WINDOW_HEIGHT / BASE_WINDOW_HEIGHT;
+}
+
+// ==========================================
+// CLASE BasicGameState<COLS, ROWS>
+// ==========================================
+// Gestiona el estado completo del juego mientras está en ejecución.
+// Incluye:
+// - Movimiento de la serpiente
+// - Generación de bloques, obstáculos y power-ups
+// - Detección de colisiones
+// - Sistema de puntuación
+// - Manejo de power-ups activos
+//
+// Las dimensiones del tablero (en celdas) son parámetros de plantilla:
+// los límites, el wrap-around y los spawns usan constantes de compilación
+// en lugar de dividir WINDOW_WIDTH/WINDOW_HEIGHT entre GRID_SIZE en cada
+// comprobación. La escala en píxeles solo la usa el renderizado.
+template <int COLS, int ROWS>
+class BasicGameState {
+public:
+    // ========== DIMENSIONES DEL TABLERO ==========
+    static constexpr int BOARD_COLS = COLS;             // Columnas del tablero
+    static constexpr int BOARD_ROWS = ROWS;             // Filas del tablero
+    static constexpr int CELL_COUNT = COLS * ROWS;      // Total de celdas
+    static constexpr bool COLS_POW2 = (COLS & (COLS - 1)) == 0;  // Wrap con máscara en X
+    static constexpr bool ROWS_POW2 = (ROWS & (ROWS - 1)) == 0;  // Wrap con máscara en Y
+    static constexpr bool SHOW_MINIMAP = CELL_COUNT >= MINIMAP_MIN_CELLS;  // Minimapa en el panel
+    
+    static_assert(COLS > 0 && ROWS > 0, "El tablero necesita al menos una celda");
+    
+    // Índice lineal de una celda en el grid
+    static constexpr int cellIndex(int x, int y) {
+        return y * COLS + x;
+    }
+    
+    // Verdadero si (x, y) está dentro del tablero (una comparación sin signo por eje)
+    static constexpr bool inBounds(int x, int y) {
+        return static_cast<unsigned>(x) < static_cast<unsigned>(COLS) &&
+               static_cast<unsigned>(y) < static_cast<unsigned>(ROWS);
+    }
+    
+    // Envuelve una coordenada que salió como mucho una celda del tablero
+    static constexpr int wrapX(int x) {
+        if constexpr (COLS_POW2) return x & (COLS - 1);
+        else return x < 0 ? COLS - 1 : (x >= COLS ? 0 : x);
+    }
+    static constexpr int wrapY(int y) {
+        if constexpr (ROWS_POW2) return y & (ROWS - 1);
+        else return y < 0 ? ROWS - 1 : (y >= ROWS ? 0 : y);
+    }
+    
+    // ========== DATOS DEL JUEGO ==========
+    std::vector<SnakeSegment> snake;        // Segmentos que forman el cuerpo de la serpiente
+    std::vector<Block> blocks;              // Bloques/manzanas a comer
+    std::vector<PowerUp> powerUps;          // Power-ups en el mapa
+    std::vector<Obstacle> obstacles;        // Obstáculos que causan game over
+    std::array<unsigned char, CELL_COUNT> cells{};  // Ocupación del tablero (CellType por celda)
+    ObstacleRegions<COLS, ROWS> obstacleRegions;    // Grupos de obstáculos (para no encerrar zonas)
+    OccupancyPyramid<COLS, ROWS> occupancy;         // Conteos por bloque para el minimapa (si SHOW_MINIMAP)
+    
+    // ========== PUNTUACIÓN Y ESTADO GENERAL ==========
+    int score = 0;                          // Puntos acumulados (10 por manzana, 20 si double score activo)
+    int applesEaten = 0;                    // Contador de manzanas comidas (afecta velocidad)
+    int magnetPickups = 0;                  // De esas, las que MAGNET llevó hasta la cabeza (no alargan la serpiente)
+    bool gameOver = false;                  // Flag de fin de juego
+    DeathCause deathCause = DEATH_NONE;     // Por qué terminó la partida
+    
+    // ========== MOVIMIENTO Y DIRECCIÓN ==========
+    int direction = 1;                      // Dirección actual (0=arriba, 1=derecha, 2=abajo, 3=izquierda)
+    int nextDirection = 1;                  // Siguiente dirección (se aplica en el siguiente frame)
+    float moveProgress = 0;                 // Fracción de celda avanzada hacia el próximo paso
+    float cellsPerSecond = BASE_CELLS_PER_SECOND;   // Velocidad actual (según speedLevel)
+    
+    // ========== VELOCIDAD ==========
+    // Nivel 1: un paso cada 10 ticks de 0.016 s; cada nivel suma lo mismo
+    static constexpr float BASE_CELLS_PER_SECOND = 6.25f;
+    static constexpr float CELLS_PER_SECOND_PER_LEVEL = 6.25f;
+    static constexpr int MAX_STEPS_PER_TICK = 8;    // Pasos por update() como máximo (500 celdas/s a 60 Hz)
+    // Tope de velocidad (desde el nivel 80): más rápido, el bucle de pasos
+    // se cortaría en MAX_STEPS_PER_TICK y la serpiente perdería celdas
+    static constexpr float MAX_CELLS_PER_SECOND = MAX_STEPS_PER_TICK / TICK_SECONDS;
+    static constexpr float STEP_TOLERANCE = 1e-4f;  // Diez sumas de 0.1 celdas cuentan como un paso
+    
+    // ========== INTERVALOS DE SPAWN ==========
+    // Se leen cada vez que se reprograma el spawn correspondiente
+    float blockSpawnDelay = 5.0f;           // Intervalo entre manzanas (5 segundos)
+    float powerUpSpawnDelay = 15.0f;        // Intervalo entre power-ups (15 segundos)
+    float obstacleSpawnDelay = 4.0f;        // Intervalo entre obstáculos (4 segundos)
+    float obstacleDestroyerSpawnDelay = 30.0f; // Aparece cada 30 segundos (solo si 15+ obstáculos)
+    static constexpr int MAX_OBSTACLES = CELL_COUNT / 8;    // Obstáculos en pantalla como máximo (150 en 40x30)
+    
+    // ========== TEMPORIZADORES ==========
+    // Todos los eventos con tiempo (spawns y fin de power-ups) en una rueda:
+    // cada tick solo se procesan los que vencen
+    TimerWheel<TIMER_COUNT> timers;
+    
+    // ========== EFECTOS ACTIVOS ==========
+    // Los activan/desactivan los hooks del registro de power-ups
+    bool wallPassActive = false;            // Si verdadero, la serpiente puede atravesar paredes
+    bool doubleScoreActive = false;         // Si verdadero, cada manzana vale 20 puntos (en lugar de 10)
+    bool magnetActive = false;              // Si verdadero, las manzanas se atraen hacia la serpiente
+    
+    // ========== OTROS ==========
+    float gameTimer = 0;                    // Timer global del juego
+    int speedLevel = 1;                     // Nivel de velocidad (aumenta con manzanas comidas)
+    
+    // ========== NÚMEROS ALEATORIOS ==========
+    // Cada partida tiene su propio generador (xorshift32) para que una
+    // semilla reproduzca exactamente la misma partida en cualquier plataforma
+    unsigned seed = 0;                      // Semilla con la que empezó la partida
+    unsigned rngState = 0;                  // Estado interno del generador
+    
+    // ========== MEMORIA TEMPORAL ==========
+    FrameArena scratch;                     // Memoria de un solo tick (se reinicia en update)
+    
+    // ========== EVENTOS DEL ÚLTIMO TICK ==========
+    // Lo que pasó en la última llamada a update(), para los efectos visuales.
+    // Capacidad fija: si se llena, los eventos sobrantes se descartan.
+    // OBSTACLE_DESTROYER genera uno por obstáculo, así que entran todos
+    // (MAX_OBSTACLES) más los del resto del tick.
+    static constexpr int MAX_EVENTS = MAX_OBSTACLES + 256;
+    std::array<GameEvent, MAX_EVENTS> events{};
+    int eventCount = 0;
+    
+    // ========== CELDAS CAMBIADAS ==========
+    // Celdas escritas (con setCell) desde el último paintBoard(), en el
+    // orden en que cambiaron; pueden repetirse. Si la lista se llena, al
+    // reiniciar o con OBSTACLE_DESTROYER se pide repintar todo el tablero.
+    static constexpr int MAX_CHANGED_CELLS = 256;
+    std::array<int, MAX_CHANGED_CELLS> changedCells{};
+    int changedCount = 0;
+    bool boardRepaint = true;               // El próximo paintBoard() repinta todo
+    
+    // ========== CONSTRUCTOR ==========
+    // Inicializa el juego con la serpiente en el centro del tablero.
+    // Cada celda tiene como mucho una entidad, así que reservar CELL_COUNT
+    // elementos evita cualquier realocación durante la partida.
+    explicit BasicGameState(unsigned seed = static_cast<unsigned>(rand())) : seed(seed) {
+        snake.reserve(CELL_COUNT);
+        blocks.reserve(CELL_COUNT);
+        powerUps.reserve(CELL_COUNT);
+        obstacles.reserve(CELL_COUNT);
+        boardVertices.resize(CELL_COUNT * 6);   // Capacidad para un tablero lleno
+        boardVertices.clear();
+        buildPanel();
+        start();
+    }
+    
+    // ========== REINICIO ==========
+    // Empieza una partida nueva reutilizando la memoria ya reservada
+    // (a diferencia de "game = GameState()", no libera ni vuelve a reservar)
+    void reset(unsigned newSeed) {
+        BasicGameState fresh(newSeed, *this);
+        *this = std::move(fresh);
+    }
+    
+    // Devuelve un entero aleatorio en [0, n)
+    int randomInt(int n) {
+        rngState ^= rngState << 13;
+        rngState ^= rngState >> 17;
+        rngState ^= rngState << 5;
+        return static_cast<int>(rngState % static_cast<unsigned>(n));
+    }
+    
+    // ========== REGISTRO DE POWER-UPS ==========
+    // Cada tipo se describe aquí: un power-up nuevo solo necesita su fila
+    // (y sus hooks), no otro bloque en update() ni en drawUI()
+    using PowerUpHook = void (BasicGameState::*)();
+    struct PowerUpDef {
+        const char* label;          // Nombre en el panel
+        sf::Color color;            // Color de la celda, la barra y los segundos
+        sf::Color panelColor;       // Fondo de su caja en el panel
+        float duration;             // Segundos que dura (0 = instantáneo)
+        StackRule stacking;         // Qué pasa si se toma estando activo
+        int spawnWeight;            // Peso en el spawn normal (0 = tiene su propia regla)
+        PowerUpHook apply;          // Al tomarlo
+        PowerUpHook expire;         // Al terminar su duración (nullptr si es instantáneo)
+    };
+    
+    static const PowerUpDef& powerUpDef(int type) {
+        static const PowerUpDef registry[POWERUP_COUNT] = {
+            {"WALL PASS", sf::Color::Yellow, sf::Color(100, 100, 0), 10.0f, STACK_REFRESH, 1,
+             &BasicGameState::startWallPass, &BasicGameState::endWallPass},
+            {"DOUBLE SCORE", sf::Color::Magenta, sf::Color(100, 0, 100), 10.0f, STACK_REFRESH, 1,
+             &BasicGameState::startDoubleScore, &BasicGameState::endDoubleScore},
+            {"MAGNET", sf::Color(255, 165, 0), sf::Color(165, 100, 0), 10.0f, STACK_REFRESH, 1,
+             &BasicGameState::startMagnet, &BasicGameState::endMagnet},
+            {"DESTROYER", sf::Color::White, sf::Color(80, 80, 80), 0.0f, STACK_REFRESH, 0,
+             &BasicGameState::destroyObstacles, nullptr},
+        };
+        return registry[type];
+    }
+    
+    // Aplica un power-up como si la serpiente lo hubiera tomado
+    void activatePowerUp(PowerUpType type) {
+        const PowerUpDef& def = powerUpDef(type);
+        (this->*def.apply)();
+        if (def.duration > 0) {
+            int timer = TIMER_POWERUP_EXPIRE + type;
+            std::uint32_t ticks = secondsToTicks(def.duration);
+            if (def.stacking == STACK_EXTEND) ticks += timers.remaining(timer);
+            timers.schedule(timer, ticks);
+        }
+    }
+    
+    // Verdadero mientras dure el power-up
+    bool powerUpActive(PowerUpType type) const {
+        return timers.active(TIMER_POWERUP_EXPIRE + type);
+    }
+    
+    // Segundos que le quedan al power-up (0 si no está activo)
+    float powerUpSecondsLeft(PowerUpType type) const {
+        return timers.remaining(TIMER_POWERUP_EXPIRE + type) * TICK_SECONDS;
+    }
+    
+    // Convierte segundos a ticks de la rueda (redondeando, al menos 1)
+    static std::uint32_t secondsToTicks(float seconds) {
+        float ticks = seconds / TICK_SECONDS + 0.5f;
+        if (ticks >= TimerWheel<TIMER_COUNT>::MAX_DELAY) return TimerWheel<TIMER_COUNT>::MAX_DELAY;
+        return ticks < 1 ? 1 : static_cast<std::uint32_t>(ticks);
+    }
+    
+    // ========== MANEJO DE ENTRADA ==========
+    // Actualiza la dirección de movimiento según la entrada del usuario
+    // Evita que la serpiente se doble sobre sí misma (no puede ir en dirección opuesta)
+    void handleInput(sf::Keyboard::Scancode key) {
+        if (key == sf::Keyboard::Scan::Up && direction != 2) nextDirection = 0;        // Arriba (no desde abajo)
+        else if (key == sf::Keyboard::Scan::Right && direction != 3) nextDirection = 1; // Derecha (no desde izquierda)
+        else if (key == sf::Keyboard::Scan::Down && direction != 0) nextDirection = 2;  // Abajo (no desde arriba)
+        else if (key == sf::Keyboard::Scan::Left && direction != 1) nextDirection = 3;  // Izquierda (no desde derecha)
+    }
+    
+    // ========== SPAWN: CELDA ALEATORIA ==========
+    // Elige una celda al azar; devuelve false si ya está ocupada por cualquier
+    // entidad (serpiente, manzana, obstáculo o power-up). Así nunca hay dos
+    // entidades en la misma celda.
+    bool randomFreeCell(int& x, int& y) {
+        x = randomInt(COLS);
+        y = randomInt(ROWS);
+        return cells[cellIndex(x, y)] == CELL_EMPTY;
+    }
+    
+    // ========== ACTUALIZACIÓN DEL JUEGO ==========
+    // Se ejecuta cada frame (60 veces por segundo)
+    // Maneja: power-ups, timers de spawn, movimiento de la serpiente, colisiones
+    void update(float deltaTime) {
+        eventCount = 0;        // Los eventos solo describen este tick
+        if (gameOver) return;  // Si el juego terminó, no actualizar nada
+        
+        gameTimer += deltaTime;  // Incrementar timer global del juego
+        
+        // ========== CÁLCULO DE VELOCIDAD ==========
+        // Cada 10 manzanas comidas, la serpiente se mueve más rápido
+        // (hasta MAX_CELLS_PER_SECOND)
+        speedLevel = 1 + (applesEaten / 10);
+        cellsPerSecond = std::min(BASE_CELLS_PER_SECOND + (speedLevel - 1) * CELLS_PER_SECOND_PER_LEVEL,
+                                  MAX_CELLS_PER_SECOND);
+        
+        // ========== TEMPORIZADORES ==========
+        // Fin de power-ups y spawns que vencen en este tick. Los spawns se
+        // ejecutan a ritmo fijo y NO afectan la velocidad de la serpiente.
+        timers.advance([this](int id) { onTimer(id); });
+        
+        // Actualizar dirección a la siguiente entrada del usuario
+        direction = nextDirection;
+        
+        scratch.reset();  // La memoria temporal del tick anterior ya no se usa
+        
+        // ========== MAGNET LOGIC ==========
+        // Si el power-up MAGNET está activo, atraer los bloques hacia la cabeza
+        if (magnetActive && !snake.empty()) {
+            SnakeSegment head = snake[0];  // Posición de la cabeza
+            int* blocksToRemove = scratch.allocate<int>(blocks.size());
+            int removeCount = 0;
+            for (int i = 0; i < (int)blocks.size(); i++) {
+                auto& block = blocks[i];
+                int blockGridX = block.x;
+                int blockGridY = block.y;
+
+                // Atraer el bloque hacia la cabeza (mover en dirección X)
+                if (blockGridX < head.x) blockGridX++;
+                else if (blockGridX > head.x) blockGridX--;
+
+                if (blockGridY < head.y) blockGridY++;
+                else if (blockGridY > head.y) blockGridY--;
+
+                // Si el bloque llega a la cabeza con MAGNET, comerlo automáticamente
+                if (blockGridX == head.x && blockGridY == head.y) {
+                    int points = doubleScoreActive ? 20 : 10;
+                    score += points;
+                    applesEaten++;
+                    magnetPickups++;
+                    setCell(cellIndex(block.x, block.y), CELL_EMPTY);
+                    pushEvent(EVENT_MAGNET_PICKUP, head.x, head.y);
+                    blocksToRemove[removeCount++] = i;
+                    continue;
+                }
+                
+                // Solo avanzar si la celda destino está libre (una entidad por celda)
+                if (cells[cellIndex(blockGridX, blockGridY)] == CELL_EMPTY) {
+                    setCell(cellIndex(block.x, block.y), CELL_EMPTY);
+                    setCell(cellIndex(blockGridX, blockGridY), CELL_APPLE);
+                    block.x = blockGridX;
+                    block.y = blockGridY;
+                }
+            }
+            // Remover bloques comidos (en orden inverso para evitar cambios de índice)
+            for (int i = removeCount - 1; i >= 0; i--) {
+                blocks.erase(blocks.begin() + blocksToRemove[i]);
+            }
+        }
+        
+        // ========== MOVIMIENTO DE LA SERPIENTE ==========
+        // La velocidad se acumula en fracciones de celda: cada celda completa
+        // es un paso con sus colisiones y lo que coma. A velocidades altas
+        // hay varios pasos en el mismo tick y ninguno se salta las
+        // comprobaciones. Los spawns (en los temporizadores de arriba) no
+        // dependen de la velocidad.
+        moveProgress += cellsPerSecond * deltaTime;
+        for (int step = 0; step < MAX_STEPS_PER_TICK && moveProgress >= 1.0f - STEP_TOLERANCE; step++) {
+            moveProgress -= 1.0f;
+            moveSnake();
+            if (gameOver) return;
+        }
+        if (moveProgress > 1.0f) moveProgress = 1.0f;  // Un tick muy largo no acumula pasos atrasados
+    }
+    
+    // ========== DIBUJAR JUEGO ==========
+    // Renderiza todos los elementos visuales en la ventana
+    // El tamaño de celda en píxeles se deriva del área de juego y del tablero.
+    // Todas las celdas van en un solo VertexArray que se reutiliza entre frames.
+    void draw(Renderer& renderer) {
+        float cellW = WINDOW_WIDTH * SCALE_X / COLS;
+        float cellH = WINDOW_HEIGHT * SCALE_Y / ROWS;
+        float gapX = cellW / GRID_SIZE;  // 1 píxel de separación por lado en el tablero estándar
+        float gapY = cellH / GRID_SIZE;
+        
+        boardVertices.clear();  // Conserva la capacidad del frame anterior
+        
+        for (const auto& segment : snake) {
+            appendCell(segment.x, segment.y, cellW, cellH, gapX, gapY, sf::Color::Green);
+        }
+        
+        for (const auto& block : blocks) {
+            appendCell(block.x, block.y, cellW, cellH, gapX, gapY, sf::Color::Red);
+        }
+        
+        for (const auto& powerUp : powerUps) {
+            appendCell(powerUp.x, powerUp.y, cellW, cellH, gapX, gapY, powerUpDef(powerUp.type).color);
+        }
+        
+        for (const auto& obstacle : obstacles) {
+            appendCell(obstacle.x, obstacle.y, cellW, cellH, gapX, gapY, sf::Color::Cyan);
+        }
+        
+        if (boardVertices.getVertexCount() > 0) {
+            renderer.drawQuads(&boardVertices[0], boardVertices.getVertexCount());
+        }
+        
+        // Línea divisoria entre el tablero y el panel
+        renderer.fillRect(WINDOW_WIDTH * SCALE_X, 0, 2, WINDOW_HEIGHT * SCALE_Y, sf::Color::White);
+    }
+
+    // Igual que draw() pero con el tablero como textura de un texel por
+    // celda (--render=grid): el costo no depende de cuántas entidades hay
+    void drawGrid(Renderer& renderer, BoardTexture& board) {
+        float cellW = WINDOW_WIDTH * SCALE_X / COLS;
+        float cellH = WINDOW_HEIGHT * SCALE_Y / ROWS;
+
+        board.sync([this](int index) { return cellColor(cells[index]); });
+        board.draw(renderer, 0, 0, cellW, cellH, cellW / GRID_SIZE, cellH / GRID_SIZE);
+
+        renderer.fillRect(WINDOW_WIDTH * SCALE_X, 0, 2, WINDOW_HEIGHT * SCALE_Y, sf::Color::White);
+    }
+
+    // ========== DIBUJO INCREMENTAL ==========
+    // Pinta el tablero (y la línea divisoria) en un destino que conserva
+    // su contenido entre frames: solo se repintan las celdas anotadas por
+    // setCell. Todo el tablero se repinta al empezar, si cambió el tamaño
+    // de las celdas o si boardRepaint está activo. Devuelve false si no
+    // hubo nada que pintar (el destino ya está al día).
+    bool paintBoard(Renderer& layer) {
+        float cellW = WINDOW_WIDTH * SCALE_X / COLS;
+        float cellH = WINDOW_HEIGHT * SCALE_Y / ROWS;
+        float gapX = cellW / GRID_SIZE;
+        float gapY = cellH / GRID_SIZE;
+        
+        // Muchos cambios: pintar todo cuesta lo mismo y no desborda el lote
+        if (cellW != paintedCellW || cellH != paintedCellH || changedCount * 2 > CELL_COUNT) {
+            boardRepaint = true;
+        }
+        if (!boardRepaint && changedCount == 0) return false;
+        
+        boardVertices.clear();
+        if (boardRepaint) {
+            layer.fillRect(0, 0, WINDOW_WIDTH * SCALE_X, WINDOW_HEIGHT * SCALE_Y, sf::Color::Black);
+            for (int index = 0; index < CELL_COUNT; index++) {
+                if (cells[index] == CELL_EMPTY) continue;
+                appendCell(index % COLS, index / COLS, cellW, cellH, gapX, gapY, cellColor(cells[index]));
+            }
+        } else {
+            // Primero se borra cada celda entera (con su separación) y
+            // después se pinta lo que tiene ahora
+            for (int i = 0; i < changedCount; i++) {
+                int index = changedCells[i];
+                appendCell(index % COLS, index / COLS, cellW, cellH, 0, 0, sf::Color::Black);
+            }
+            for (int i = 0; i < changedCount; i++) {
+                int index = changedCells[i];
+                if (cells[index] == CELL_EMPTY) continue;
+                appendCell(index % COLS, index / COLS, cellW, cellH, gapX, gapY, cellColor(cells[index]));
+            }
+        }
+        if (boardVertices.getVertexCount() > 0) {
+            layer.drawQuads(&boardVertices[0], boardVertices.getVertexCount());
+        }
+        if (boardRepaint) {
+            layer.fillRect(WINDOW_WIDTH * SCALE_X, 0, 2, WINDOW_HEIGHT * SCALE_Y, sf::Color::White);
+        }
+        
+        paintedCellW = cellW;
+        paintedCellH = cellH;
+        changedCount = 0;
+        boardRepaint = false;
+        return true;
+    }
+    
+    // El próximo paintBoard() repinta todo (reinicio, cambio de tamaño,
+    // destino nuevo o cambios masivos del tablero)
+    void requestBoardRepaint() {
+        boardRepaint = true;
+        changedCount = 0;
+    }
+
+    // Color con el que se dibuja cada tipo de celda
+    static sf::Color cellColor(unsigned char cell) {
+        switch (cell) {
+            case CELL_EMPTY:    return sf::Color::Transparent;
+            case CELL_SNAKE:    return sf::Color::Green;
+            case CELL_APPLE:    return sf::Color::Red;
+            case CELL_OBSTACLE: return sf::Color::Cyan;
+            default:            return powerUpDef(static_cast<PowerUpType>(cell - CELL_POWERUP)).color;
+        }
+    }
+    
+    void drawUI(Renderer& renderer) {
+        float panelStartX = WINDOW_WIDTH * SCALE_X;
+        float panelX = panelStartX + 15;
+        float panelW = PANEL_WIDTH - 20;
+        char text[HudBatch::MAX_TEXT + 1];
+        
+        hud.setRect(ui.panel, panelStartX + 5, 0, PANEL_WIDTH - 10, WINDOW_HEIGHT * SCALE_Y, sf::Color(0, 0, 0, 200));
+        
+        float yPos = 10;
+        
+        // Puntaje
+        hud.setRect(ui.scoreBg, panelX, yPos, panelW, 25, sf::Color(50, 50, 50));
+        hud.setRect(ui.separator, panelX, yPos + 25, panelW, 1, sf::Color::White);
+        hud.setText(ui.scoreLabel, "SCORE", panelX + 6, yPos + 5, 2, sf::Color(200, 200, 200));
+        std::snprintf(text, sizeof(text), "%d", score);
+        setValueText(ui.scoreValue, text, panelX + panelW - 6, yPos + 5, sf::Color::White);
+        
+        yPos += 35;
+        
+        // Manzanas comidas
+        hud.setRect(ui.applesBg, panelX, yPos, panelW, 22, sf::Color(100, 0, 0));
+        hud.setFrame(ui.applesFrame, panelX, yPos, panelW, 22, 2, sf::Color::Red);
+        hud.setRect(ui.appleIcon, panelX + 6, yPos + 7, 8, 8, sf::Color::Red);
+        hud.setText(ui.applesLabel, "APPLES", panelX + 20, yPos + 4, 2, sf::Color::White);
+        std::snprintf(text, sizeof(text), "%d", applesEaten);
+        setValueText(ui.applesValue, text, panelX + panelW - 6, yPos + 4, sf::Color::White);
+        
+        yPos += 28;
+        
+        // Puntos por manzana
+        int pointsPerApple = doubleScoreActive ? 20 : 10;
+        hud.setRect(ui.pointsBg, panelX, yPos, panelW, 22, sf::Color(0, 120, 0));
+        hud.setFrame(ui.pointsFrame, panelX, yPos, panelW, 22, 1, sf::Color::Green);
+        hud.setText(ui.pointsLabel, "PTS/APPLE", panelX + 6, yPos + 4, 2, sf::Color::White);
+        std::snprintf(text, sizeof(text), "+%d", pointsPerApple);
+        setValueText(ui.pointsValue, text, panelX + panelW - 6, yPos + 4, sf::Color::Green);
+        
+        yPos += 28;
+        
+        // Nivel de velocidad
+        hud.setRect(ui.speedLine, panelX, yPos, panelW, 3, sf::Color::Yellow);
+        hud.setText(ui.speedLabel, "SPEED", panelX + 6, yPos + 9, 2, sf::Color::Yellow);
+        std::snprintf(text, sizeof(text), "LV %d", speedLevel);
+        setValueText(ui.speedValue, text, panelX + panelW - 6, yPos + 9, sf::Color::Yellow);
+        
+        yPos += 30;
+        
+        // Power-ups activos con sus segundos restantes (en el orden del registro)
+        for (int type = 0; type < POWERUP_COUNT; type++) {
+            drawPowerUpRow(ui.powerUps[type], static_cast<PowerUpType>(type), panelX, panelW, yPos);
+        }
+        
+        // Minimapa al pie del panel (tableros grandes): solo se recolorean
+        // los bloques que cambiaron desde el frame anterior
+        float mapY = 0;
+        if constexpr (SHOW_MINIMAP) {
+            minimap.sync(occupancy);
+            sf::Vector2f mapSize = minimap.size(panelW);
+            mapY = WINDOW_HEIGHT * SCALE_Y - mapSize.y - 12;
+            hud.setText(ui.minimapLabel, "MAP", panelX, mapY - 20, 2, sf::Color(200, 200, 200));
+            hud.setFrame(ui.minimapFrame, panelX - 2, mapY - 2, mapSize.x + 4, mapSize.y + 4, 2, sf::Color(200, 200, 200));
+        }
+        
+        // Todo el panel en una sola llamada
+        hud.draw(renderer);
+        if constexpr (SHOW_MINIMAP) minimap.draw(renderer, panelX, mapY, panelW);
+    }
+    
+private:
+    // ========== FORMAS REUTILIZABLES ==========
+    // Se reutilizan en cada frame para no reservar memoria al dibujar
+    sf::VertexArray boardVertices{sf::Triangles};   // Todas las celdas del tablero (un solo draw)
+    float paintedCellW = 0, paintedCellH = 0;       // Tamaño de celda del último paintBoard()
+    
+    // ========== PANEL LATERAL ==========
+    // Slots del HudBatch (rangos fijos de vértices, reservados en el constructor)
+    struct PowerUpSlots { int background, bar, frame, label, seconds; };
+    struct PanelSlots {
+        int panel, scoreBg, separator, scoreLabel, scoreValue;
+        int applesBg, applesFrame, appleIcon, applesLabel, applesValue;
+        int pointsBg, pointsFrame, pointsLabel, pointsValue;
+        int speedLine, speedLabel, speedValue;
+        PowerUpSlots powerUps[POWERUP_COUNT];
+        int minimapLabel, minimapFrame;
+    };
+    HudBatch hud;                                   // Fondos, barras y texto del panel
+    PanelSlots ui{};                                // Índices de cada elemento en 'hud'
+    Minimap minimap;                                // Textura del minimapa (si SHOW_MINIMAP)
+    
+    // Constructor de reset(): toma los buffers ya reservados de 'storage'
+    // (construidos por movimiento: un miembro construido por defecto y
+    // reemplazado después ya habría reservado su propia memoria)
+    BasicGameState(unsigned seed, BasicGameState& storage)
+        : snake(std::move(storage.snake)),
+          blocks(std::move(storage.blocks)),
+          powerUps(std::move(storage.powerUps)),
+          obstacles(std::move(storage.obstacles)),
+          seed(seed),
+          scratch(std::move(storage.scratch)),
+          boardVertices(std::move(storage.boardVertices)),
+          hud(std::move(storage.hud)),
+          ui(storage.ui),
+          minimap(std::move(storage.minimap)) {
+        snake.clear();
+        blocks.clear();
+        powerUps.clear();
+        obstacles.clear();
+        start();
+    }
+    
+    // Estado inicial común: generador, serpiente en el centro y primeros spawns
+    void start() {
+        rngState = seed ? seed : 0x9E3779B9u;  // xorshift no admite estado 0
+        snake.push_back(SnakeSegment(COLS / 2, ROWS / 2));
+        occupancy.clear();
+        trackOccupancy(cellIndex(COLS / 2, ROWS / 2), CELL_SNAKE);
+        cells[cellIndex(COLS / 2, ROWS / 2)] = CELL_SNAKE;
+        obstacleRegions.clear();
+        requestBoardRepaint();
+        timers.schedule(TIMER_APPLE_SPAWN, secondsToTicks(blockSpawnDelay));
+        timers.schedule(TIMER_POWERUP_SPAWN, secondsToTicks(powerUpSpawnDelay));
+        timers.schedule(TIMER_OBSTACLE_SPAWN, secondsToTicks(obstacleSpawnDelay));
+    }
+    
+    // ========== TEMPORIZADORES VENCIDOS ==========
+    // Los spawns intentan crear su entidad y se reprograman con el intervalo
+    // actual; los de fin de power-up llaman al hook 'expire' del registro
+    void onTimer(int id) {
+        switch (id) {
+            case TIMER_APPLE_SPAWN:
+                spawnApple();
+                timers.schedule(id, secondsToTicks(blockSpawnDelay));
+                break;
+            case TIMER_POWERUP_SPAWN:
+                spawnPowerUp();
+                timers.schedule(id, secondsToTicks(powerUpSpawnDelay));
+                break;
+            case TIMER_OBSTACLE_SPAWN:
+                spawnObstacle();
+                timers.schedule(id, secondsToTicks(obstacleSpawnDelay));
+                break;
+            case TIMER_DESTROYER_SPAWN:
+                spawnDestroyer();
+                obstaclesChanged();  // Se reprograma si sigue habiendo 15+ obstáculos
+                break;
+            default: {
+                const PowerUpDef& def = powerUpDef(id - TIMER_POWERUP_EXPIRE);
+                if (def.expire) (this->*def.expire)();
+                break;
+            }
+        }
+    }
+    
+    // ========== UN PASO DE LA SERPIENTE ==========
+    // Avanza la cabeza una celda en 'direction': choques, comer y cola
+    void moveSnake() {
+        // ========== CÁLCULO DE NUEVA POSICIÓN DE CABEZA ==========
+        // Crear nueva cabeza basada en dirección actual
+        SnakeSegment head = snake[0];  // Copiar posición actual
+        if (direction == 0) head.y--;           // Arriba: decrementar Y
+        else if (direction == 1) head.x++;      // Derecha: incrementar X
+        else if (direction == 2) head.y++;      // Abajo: incrementar Y
+        else if (direction == 3) head.x--;      // Izquierda: decrementar X
+        
+        // ========== COLISIÓN: PAREDES ==========
+        // Verificar si la cabeza sale de los límites del tablero
+        if (!wallPassActive) {
+            // Sin power-up: colisionar con paredes causa game over
+            if (!inBounds(head.x, head.y)) {
+                gameOver = true;
+                deathCause = DEATH_WALL;
+                pushEvent(EVENT_DEATH, snake[0].x, snake[0].y);
+                return;
+            }
+        } else {
+            // Con WALL_PASS: envolver a la posición opuesta (efecto de túnel)
+            head.x = wrapX(head.x);
+            head.y = wrapY(head.y);
+        }
+        
+        unsigned char headCell = cells[cellIndex(head.x, head.y)];
+        
+        // ========== COLISIÓN: SERPIENTE U OBSTÁCULO ==========
+        // Una sola consulta al grid. La cola todavía ocupa su celda en este
+        // punto, así que chocar con ella también termina el juego (igual que antes)
+        if (headCell == CELL_SNAKE || headCell == CELL_OBSTACLE) {
+            gameOver = true;
+            deathCause = headCell == CELL_SNAKE ? DEATH_SELF : DEATH_OBSTACLE;
+            pushEvent(EVENT_DEATH, head.x, head.y);
+            return;
+        }
+        
+        // ========== MOVIMIENTO: INSERTAR CABEZA ==========
+        // Agregar la nueva cabeza al inicio de la lista
+        snake.insert(snake.begin(), head);
+        unsigned char eatenCell = headCell;  // Lo que había en la celda antes de entrar
+        setCell(cellIndex(head.x, head.y), CELL_SNAKE);
+        
+        // ========== COMER: BLOQUES/MANZANAS ==========
+        // Verificar si la cabeza está en la posición de alguna manzana
+        bool ateBlock = false;  // Flag para saber si comió algo (decide si crece)
+        if (eatenCell == CELL_APPLE) {
+            for (auto it = blocks.begin(); it != blocks.end(); ++it) {
+                if (head.x == it->x && head.y == it->y) {
+                    // Calcular puntos (double si power-up activo)
+                    int points = doubleScoreActive ? 20 : 10;
+                    score += points;
+                    applesEaten++;  // Incrementar contador (afecta velocidad)
+                    blocks.erase(it);  // Remover la manzana
+                    pushEvent(EVENT_APPLE_EATEN, head.x, head.y);
+                    ateBlock = true;
+                    break;
+                }
+            }
+        }
+        
+        // ========== COMER: POWER-UPS ==========
+        // Verificar si la cabeza está en la posición de algún power-up
+        if (isPowerUpCell(eatenCell)) {
+            for (auto it = powerUps.begin(); it != powerUps.end(); ++it) {
+                if (head.x == it->x && head.y == it->y) {
+                    pushEvent(EVENT_POWERUP_TAKEN, head.x, head.y, it->type);
+                    activatePowerUp(it->type);  // Efecto y duración según el registro
+                    // Remover el power-up consumido
+                    powerUps.erase(it);
+                    break;
+                }
+            }
+        }
+        
+        // ========== CRECIMIENTO/ENCOGIMIENTO DE LA SERPIENTE ==========
+        // Si NO comió nada, remover el último segmento (la serpiente no crece)
+        // Si comió, mantiene el segmento extra (la serpiente crece)
+        if (!ateBlock && snake.size() > 1) {
+            const SnakeSegment& tail = snake.back();
+            setCell(cellIndex(tail.x, tail.y), CELL_EMPTY);
+            snake.pop_back();  // Remover cola
+        }
+    }
+    
+    // ========== SPAWNS ==========
+    // Manzanas: aumentan puntuación y velocidad
+    void spawnApple() {
+        int randomX, randomY;
+        if (randomFreeCell(randomX, randomY)) {
+            blocks.push_back(Block(randomX, randomY));
+            setCell(cellIndex(randomX, randomY), CELL_APPLE);
+        }
+    }
+    
+    // Power-ups normales: tipo elegido según spawnWeight del registro
+    void spawnPowerUp() {
+        int randomX, randomY;
+        if (!randomFreeCell(randomX, randomY)) return;
+        int totalWeight = 0;
+        for (int type = 0; type < POWERUP_COUNT; type++) totalWeight += powerUpDef(type).spawnWeight;
+        int pick = randomInt(totalWeight);
+        PowerUpType type = WALL_PASS;
+        for (int t = 0; t < POWERUP_COUNT; t++) {
+            if (pick < powerUpDef(t).spawnWeight) {
+                type = static_cast<PowerUpType>(t);
+                break;
+            }
+            pick -= powerUpDef(t).spawnWeight;
+        }
+        powerUps.push_back(PowerUp(randomX, randomY, type));
+        setCell(cellIndex(randomX, randomY), powerUpCell(type));
+    }
+    
+    // Obstáculos: causan game over al chocar (máximo MAX_OBSTACLES en pantalla).
+    // No se ponen donde cerrarían un anillo: las celdas sin obstáculo (y con
+    // ellas las manzanas y power-ups) quedan siempre conectadas entre sí.
+    void spawnObstacle() {
+        int randomX, randomY;
+        if (randomFreeCell(randomX, randomY) && (int)obstacles.size() < MAX_OBSTACLES &&
+            !obstacleRegions.wouldSeal(randomX, randomY)) {
+            obstacles.push_back(Obstacle(randomX, randomY));
+            obstacleRegions.add(randomX, randomY);
+            setCell(cellIndex(randomX, randomY), CELL_OBSTACLE);
+            obstaclesChanged();
+        }
+    }
+    
+    // OBSTACLE_DESTROYER: power-up blanco que destruye todos los obstáculos
+    void spawnDestroyer() {
+        int randomX, randomY;
+        if (obstacles.size() >= 15 && randomFreeCell(randomX, randomY)) {
+            powerUps.push_back(PowerUp(randomX, randomY, OBSTACLE_DESTROYER));
+            setCell(cellIndex(randomX, randomY), powerUpCell(OBSTACLE_DESTROYER));
+        }
+    }
+    
+    // El destructor solo se programa mientras haya 15 o más obstáculos;
+    // si bajan de 15 la cuenta se cancela y vuelve a empezar desde cero
+    void obstaclesChanged() {
+        if (obstacles.size() >= 15) {
+            if (!timers.active(TIMER_DESTROYER_SPAWN)) {
+                timers.schedule(TIMER_DESTROYER_SPAWN, secondsToTicks(obstacleDestroyerSpawnDelay));
+            }
+        } else {
+            timers.cancel(TIMER_DESTROYER_SPAWN);
+        }
+    }
+    
+    // ========== HOOKS DEL REGISTRO DE POWER-UPS ==========
+    void startWallPass() { wallPassActive = true; }       // Atravesar paredes
+    void endWallPass() { wallPassActive = false; }
+    void startDoubleScore() { doubleScoreActive = true; } // 20 puntos por manzana
+    void endDoubleScore() { doubleScoreActive = false; }
+    void startMagnet() { magnetActive = true; }           // Atraer manzanas
+    void endMagnet() { magnetActive = false; }
+    
+    // OBSTACLE_DESTROYER: eliminar TODOS los obstáculos y ganar 50 de bonus
+    void destroyObstacles() {
+        for (const auto& obstacle : obstacles) {
+            trackOccupancy(cellIndex(obstacle.x, obstacle.y), CELL_EMPTY);
+            cells[cellIndex(obstacle.x, obstacle.y)] = CELL_EMPTY;
+            pushEvent(EVENT_OBSTACLE_DESTROYED, obstacle.x, obstacle.y);
+        }
+        obstacles.clear();
+        obstacleRegions.clear();
+        requestBoardRepaint();
+        score += 50;
+        obstaclesChanged();
+    }
+    
+    // Agrega una celda (dos triángulos) al lote del tablero
+    void appendCell(int x, int y, float cellW, float cellH, float gapX, float gapY, sf::Color color) {
+        float left = x * cellW + gapX;
+        float top = y * cellH + gapY;
+        float right = (x + 1) * cellW - gapX;
+        float bottom = (y + 1) * cellH - gapY;
+        boardVertices.append(sf::Vertex(sf::Vector2f(left, top), color));
+        boardVertices.append(sf::Vertex(sf::Vector2f(right, top), color));
+        boardVertices.append(sf::Vertex(sf::Vector2f(right, bottom), color));
+        boardVertices.append(sf::Vertex(sf::Vector2f(left, top), color));
+        boardVertices.append(sf::Vertex(sf::Vector2f(right, bottom), color));
+        boardVertices.append(sf::Vertex(sf::Vector2f(left, bottom), color));
+    }
+    
+    // Escribe una celda del tablero y la anota para paintBoard() y el minimapa
+    void setCell(int index, unsigned char type) {
+        trackOccupancy(index, type);
+        cells[index] = type;
+        if (boardRepaint) return;
+        if (changedCount < MAX_CHANGED_CELLS) changedCells[changedCount++] = index;
+        else boardRepaint = true;
+    }
+    
+    // Cuenta el cambio de la celda en la pirámide del minimapa (antes de escribirla)
+    void trackOccupancy(int index, unsigned char type) {
+        if constexpr (SHOW_MINIMAP) {
+            occupancy.change(index % COLS, index / COLS, minimapLayer(cells[index]), minimapLayer(type));
+        }
+    }
+    
+    // Registra un evento del tick (se descarta si la lista está llena)
+    void pushEvent(GameEventType type, int x, int y, int detail = 0) {
+        if (eventCount < MAX_EVENTS) events[eventCount++] = GameEvent{type, x, y, detail};
+    }
+    
+    // Reserva los slots del panel en el orden en que se dibujan
+    void buildPanel() {
+        ui.panel = hud.addRect();
+        ui.scoreBg = hud.addRect();
+        ui.separator = hud.addRect();
+        ui.scoreLabel = hud.addText(5);
+        ui.scoreValue = hud.addText(11);
+        ui.applesBg = hud.addRect();
+        ui.applesFrame = hud.addFrame();
+        ui.appleIcon = hud.addRect();
+        ui.applesLabel = hud.addText(6);
+        ui.applesValue = hud.addText(11);
+        ui.pointsBg = hud.addRect();
+        ui.pointsFrame = hud.addFrame();
+        ui.pointsLabel = hud.addText(9);
+        ui.pointsValue = hud.addText(4);
+        ui.speedLine = hud.addRect();
+        ui.speedLabel = hud.addText(5);
+        ui.speedValue = hud.addText(6);
+        for (PowerUpSlots& row : ui.powerUps) {
+            row.background = hud.addRect();
+            row.bar = hud.addRect();
+            row.frame = hud.addFrame();
+            row.label = hud.addText(12);
+            row.seconds = hud.addText(5);
+        }
+        if constexpr (SHOW_MINIMAP) {
+            ui.minimapLabel = hud.addText(3);
+            ui.minimapFrame = hud.addFrame();
+        }
+    }
+    
+    // Texto alineado a la derecha terminando en 'rightX'
+    void setValueText(int slot, const char* text, float rightX, float y, sf::Color color) {
+        hud.setText(slot, text, rightX - HudBatch::textWidth(std::strlen(text), 2), y, 2, color);
+    }
+    
+    // Caja de un power-up: nombre, segundos restantes y barra de progreso.
+    // Las cajas activas se apilan desde 'yPos'; las inactivas se ocultan.
+    void drawPowerUpRow(const PowerUpSlots& row, PowerUpType type, float panelX, float panelW, float& yPos) {
+        if (!powerUpActive(type)) {
+            hud.hide(row.background);
+            hud.hide(row.bar);
+            hud.hide(row.frame);
+            hud.hide(row.label);
+            hud.hide(row.seconds);
+            return;
+        }
+        const PowerUpDef& def = powerUpDef(type);
+        float secondsLeft = powerUpSecondsLeft(type);
+        char text[HudBatch::MAX_TEXT + 1];
+        std::snprintf(text, sizeof(text), "%.1fs", secondsLeft);
+        hud.setRect(row.background, panelX, yPos, panelW, 35, def.panelColor);
+        hud.setRect(row.bar, panelX, yPos + 28, panelW * (secondsLeft / def.duration), 5, def.color);
+        hud.setFrame(row.frame, panelX, yPos, panelW, 35, 2, def.color);
+        hud.setText(row.label, def.label, panelX + 6, yPos + 8, 2, sf::Color::White);
+        setValueText(row.seconds, text, panelX + panelW - 6, yPos + 8, def.color);
+        yPos += 40;
+    }
+};
+
+// ========== PRESETS DE TABLERO ==========
+// Tamaños de tablero instanciados en compilación
+using SmallGameState = BasicGameState<20, 15>;   // Tablero pequeño (celdas grandes)
+using GameState = BasicGameState<40, 30>;        // Tablero estándar (800x600 / 20)
+using LargeGameState = BasicGameState<64, 48>;   // Tablero grande (wrap en X con máscara)
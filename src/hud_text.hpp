@@ -0,0 +1,272 @@
+// ============================================================
+// SNAKE vs BLOCKS - Texto del panel lateral (atlas de glifos)
+// ============================================================
+// Fuente de mapa de bits 5x7 incrustada en el código. Al primer uso
+// se rasteriza en una imagen pequeña (el atlas) junto con un bloque
+// blanco sólido para los rectángulos. Todo el panel (fondos, barras y
+// texto) se escribe en un solo sf::VertexArray y se dibuja con una
+// sola llamada.
+//
+// Cada elemento ocupa un rango fijo de vértices (su "slot"). Un slot
+// solo se regenera cuando cambia su contenido: si el texto, la
+// posición y el color son los mismos que en el frame anterior, no se
+// toca ningún vértice.
+// ============================================================
+#pragma once
+
+#include <SFML/Graphics.hpp>  // Imagen y vértices
+#include <array>              // Tabla de caracteres
+#include <cstddef>            // size_t
+#include <cstring>            // strncmp, strlen
+#include <vector>             // Slots
+#include "renderer.hpp"       // Renderer y Picture
+
+// ============================================================
+// FUENTE 5x7
+// ============================================================
+namespace HudFont {
+
+constexpr int GLYPH_W = 5;                      // Ancho de un glifo (píxeles)
+constexpr int GLYPH_H = 7;                      // Alto de un glifo
+constexpr int CELL_W = GLYPH_W + 1;             // Celda en el atlas (1 px de separación)
+constexpr int CELL_H = GLYPH_H + 1;
+constexpr int ATLAS_COLUMNS = 16;               // Glifos por fila del atlas
+
+// Caracteres disponibles, en el orden de GLYPHS (las minúsculas que no
+// están aquí se dibujan como su mayúscula)
+constexpr char CHARSET[] = " 0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ:./-+xs";
+constexpr int GLYPH_COUNT = sizeof(CHARSET) - 1;
+
+// Una fila por byte; el bit 4 es la columna izquierda
+constexpr unsigned char GLYPHS[GLYPH_COUNT][GLYPH_H] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // ' '
+    {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E},  // 0
+    {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E},  // 1
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F},  // 2
+    {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E},  // 3
+    {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02},  // 4
+    {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E},  // 5
+    {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E},  // 6
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08},  // 7
+    {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E},  // 8
+    {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C},  // 9
+    {0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11},  // A
+    {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E},  // B
+    {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E},  // C
+    {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C},  // D
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F},  // E
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10},  // F
+    {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F},  // G
+    {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},  // H
+    {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E},  // I
+    {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C},  // J
+    {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11},  // K
+    {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F},  // L
+    {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11},  // M
+    {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11},  // N
+    {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},  // O
+    {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10},  // P
+    {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D},  // Q
+    {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11},  // R
+    {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E},  // S
+    {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04},  // T
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},  // U
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04},  // V
+    {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A},  // W
+    {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11},  // X
+    {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04},  // Y
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F},  // Z
+    {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00},  // :
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C},  // .
+    {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00},  // /
+    {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00},  // -
+    {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00},  // +
+    {0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11},  // x
+    {0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E},  // s
+};
+
+// Celda del atlas con el bloque blanco sólido (justo después del último glifo)
+constexpr int SOLID_CELL = GLYPH_COUNT;
+constexpr int ATLAS_ROWS = (GLYPH_COUNT + 1 + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS;
+
+// Tabla ASCII -> índice de glifo (0 = espacio para lo desconocido)
+constexpr std::array<unsigned char, 128> makeLookup() {
+    std::array<unsigned char, 128> table{};
+    for (int i = 0; i < GLYPH_COUNT; i++) table[static_cast<unsigned char>(CHARSET[i])] = static_cast<unsigned char>(i);
+    for (int c = 'a'; c <= 'z'; c++) {
+        if (table[c] == 0) table[c] = table[c - 'a' + 'A'];
+    }
+    return table;
+}
+
+inline constexpr std::array<unsigned char, 128> LOOKUP = makeLookup();
+
+inline int glyphIndex(char c) {
+    unsigned char u = static_cast<unsigned char>(c);
+    return u < 128 ? LOOKUP[u] : 0;
+}
+
+// Atlas compartido por todos los paneles; se crea una sola vez
+inline const Picture& atlas() {
+    static const Picture picture = [] {
+        sf::Image image;
+        image.create(ATLAS_COLUMNS * CELL_W, ATLAS_ROWS * CELL_H, sf::Color::Transparent);
+        for (int g = 0; g < GLYPH_COUNT; g++) {
+            int originX = (g % ATLAS_COLUMNS) * CELL_W;
+            int originY = (g / ATLAS_COLUMNS) * CELL_H;
+            for (int row = 0; row < GLYPH_H; row++) {
+                for (int col = 0; col < GLYPH_W; col++) {
+                    if (GLYPHS[g][row] & (0x10 >> col)) {
+                        image.setPixel(originX + col, originY + row, sf::Color::White);
+                    }
+                }
+            }
+        }
+        int solidX = (SOLID_CELL % ATLAS_COLUMNS) * CELL_W;
+        int solidY = (SOLID_CELL / ATLAS_COLUMNS) * CELL_H;
+        for (int row = 0; row < CELL_H; row++) {
+            for (int col = 0; col < CELL_W; col++) image.setPixel(solidX + col, solidY + row, sf::Color::White);
+        }
+        Picture result;
+        result.create(image);  // Sin suavizado: píxeles nítidos al escalar
+        return result;
+    }();
+    return picture;
+}
+
+}  // namespace HudFont
+
+// ============================================================
+// CLASE: HudBatch
+// ============================================================
+// Lote de quads texturizados con el atlas. Los slots se reservan una
+// vez (addRect/addFrame/addText) y luego se actualizan cada frame con
+// setRect/setFrame/setText, que no hacen nada si el contenido no cambió.
+class HudBatch {
+public:
+    static constexpr int MAX_TEXT = 31;  // Caracteres máximos por slot de texto
+
+    // ========== RESERVA DE SLOTS ==========
+    // Rectángulo relleno (1 quad)
+    int addRect() { return addSlot(1); }
+    // Borde de rectángulo (4 quads), dibujado por fuera como el outline de SFML
+    int addFrame() { return addSlot(4); }
+    // Texto de hasta maxChars caracteres (1 quad por carácter)
+    int addText(int maxChars) { return addSlot(maxChars < MAX_TEXT ? maxChars : MAX_TEXT); }
+
+    // ========== ACTUALIZACIÓN ==========
+    void setRect(int slot, float x, float y, float w, float h, sf::Color color) {
+        Slot& s = slots[slot];
+        if (s.visible && s.x == x && s.y == y && s.w == w && s.h == h && s.color == color) return;
+        s.visible = true;
+        s.x = x; s.y = y; s.w = w; s.h = h; s.color = color;
+        writeSolidQuad(s.firstVertex, x, y, w, h, color);
+    }
+
+    void setFrame(int slot, float x, float y, float w, float h, float thickness, sf::Color color) {
+        Slot& s = slots[slot];
+        if (s.visible && s.x == x && s.y == y && s.w == w && s.h == h && s.size == thickness && s.color == color) return;
+        s.visible = true;
+        s.x = x; s.y = y; s.w = w; s.h = h; s.size = thickness; s.color = color;
+        float t = thickness;
+        writeSolidQuad(s.firstVertex, x - t, y - t, w + 2 * t, t, color);       // Arriba
+        writeSolidQuad(s.firstVertex + 6, x - t, y + h, w + 2 * t, t, color);   // Abajo
+        writeSolidQuad(s.firstVertex + 12, x - t, y, t, h, color);              // Izquierda
+        writeSolidQuad(s.firstVertex + 18, x + w, y, t, h, color);              // Derecha
+    }
+
+    // 'pixelSize' es el tamaño en pantalla de cada píxel de la fuente
+    void setText(int slot, const char* text, float x, float y, float pixelSize, sf::Color color) {
+        Slot& s = slots[slot];
+        std::size_t length = std::strlen(text);
+        if (length > static_cast<std::size_t>(s.quadCount)) length = s.quadCount;
+        if (s.visible && s.x == x && s.y == y && s.size == pixelSize && s.color == color &&
+            s.length == length && std::strncmp(s.text, text, length) == 0) {
+            return;
+        }
+        s.visible = true;
+        s.x = x; s.y = y; s.size = pixelSize; s.color = color;
+        s.length = length;
+        std::memcpy(s.text, text, length);
+
+        float advance = HudFont::CELL_W * pixelSize;
+        for (int i = 0; i < s.quadCount; i++) {
+            std::size_t v = s.firstVertex + i * 6;
+            if (static_cast<std::size_t>(i) < length) {
+                writeQuad(v, x + i * advance, y, HudFont::GLYPH_W * pixelSize, HudFont::GLYPH_H * pixelSize,
+                          HudFont::glyphIndex(text[i]), color, false);
+            } else {
+                clearQuad(v);
+            }
+        }
+    }
+
+    // Oculta un slot (sus quads quedan sin área)
+    void hide(int slot) {
+        Slot& s = slots[slot];
+        if (!s.visible) return;
+        s.visible = false;
+        for (int i = 0; i < s.quadCount; i++) clearQuad(s.firstVertex + i * 6);
+    }
+
+    // Ancho en pantalla de un texto de 'length' caracteres
+    static float textWidth(std::size_t length, float pixelSize) {
+        return length == 0 ? 0 : (length * HudFont::CELL_W - 1) * pixelSize;
+    }
+
+    // ========== DIBUJO ==========
+    // Todo el lote en una sola llamada
+    void draw(Renderer& renderer) const {
+        if (vertices.getVertexCount() == 0) return;
+        renderer.drawQuads(&vertices[0], vertices.getVertexCount(), &HudFont::atlas());
+    }
+
+private:
+    struct Slot {
+        std::size_t firstVertex = 0;    // Primer vértice del rango del slot
+        int quadCount = 0;              // Quads reservados
+        bool visible = false;
+        float x = 0, y = 0, w = 0, h = 0, size = 0;
+        sf::Color color;
+        std::size_t length = 0;         // Texto actual (solo slots de texto)
+        char text[MAX_TEXT] = {};
+    };
+
+    std::vector<Slot> slots;
+    sf::VertexArray vertices{sf::Triangles};
+
+    int addSlot(int quadCount) {
+        Slot slot;
+        slot.firstVertex = vertices.getVertexCount();
+        slot.quadCount = quadCount;
+        slots.push_back(slot);
+        vertices.resize(slot.firstVertex + quadCount * 6);  // Vértices en cero: sin área hasta el primer set
+        return static_cast<int>(slots.size()) - 1;
+    }
+
+    void writeSolidQuad(std::size_t v, float x, float y, float w, float h, sf::Color color) {
+        writeQuad(v, x, y, w, h, HudFont::SOLID_CELL, color, true);
+    }
+
+    // Escribe dos triángulos con la celda 'cell' del atlas. En el bloque
+    // sólido se usa solo el centro para no muestrear el borde.
+    void writeQuad(std::size_t v, float x, float y, float w, float h, int cell, sf::Color color, bool solid) {
+        float u0 = static_cast<float>((cell % HudFont::ATLAS_COLUMNS) * HudFont::CELL_W);
+        float v0 = static_cast<float>((cell / HudFont::ATLAS_COLUMNS) * HudFont::CELL_H);
+        float u1 = u0 + HudFont::GLYPH_W;
+        float v1 = v0 + HudFont::GLYPH_H;
+        if (solid) {
+            u0 += 2; v0 += 2; u1 = u0 + 1; v1 = v0 + 1;
+        }
+        vertices[v + 0] = sf::Vertex(sf::Vector2f(x, y), color, sf::Vector2f(u0, v0));
+        vertices[v + 1] = sf::Vertex(sf::Vector2f(x + w, y), color, sf::Vector2f(u1, v0));
+        vertices[v + 2] = sf::Vertex(sf::Vector2f(x + w, y + h), color, sf::Vector2f(u1, v1));
+        vertices[v + 3] = sf::Vertex(sf::Vector2f(x, y), color, sf::Vector2f(u0, v0));
+        vertices[v + 4] = sf::Vertex(sf::Vector2f(x + w, y + h), color, sf::Vector2f(u1, v1));
+        vertices[v + 5] = sf::Vertex(sf::Vector2f(x, y + h), color, sf::Vector2f(u0, v1));
+    }
+
+    void clearQuad(std::size_t v) {
+        for (int i = 0; i < 6; i++) vertices[v + i] = sf::Vertex();
+    }
+};
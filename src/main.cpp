@@ -7,6 +7,17 @@
 // ============================================================
 // LIBRERÍAS INCLUIDAS
 // ============================================================
+#include "game_state.hpp"     // Estado y simulación del juego
+#include "alloc_check.hpp"    // Verificación de cero reservas por frame
+#include "session_store.hpp"  // Registro de partidas y récords
+#include "particles.hpp"      // Efectos de partículas
+#include "renderer.hpp"       // Destino de dibujo (ventana o caché)
+#include "arena.hpp"          // Modo arena (muchas serpientes)
+#include "spectator_feed.hpp" // Estado en memoria compartida (--spectator)
+#include "autopilot.hpp"      // Serpiente de la demostración
+#include "replay.hpp"         // Grabación y reproducción de partidas
+#include "fast_forward.hpp"   // Varios ticks por frame (demostración y repeticiones)
+#include <memory>             // unique_ptr (arena)
 #include <SFML/Graphics.hpp>  // Gráficos y renderizado
 #include <SFML/Audio.hpp>
 #include <iostream>           // Para debug output
@@ -16,36 +27,8 @@
 #include <ctime>              // Para seed del RNG
 #include <string>             // Manejo de strings
 #include <sstream>            // Conversión a strings
-
-// ============================================================
-// CONSTANTES DE CONFIGURACIÓN
-// ============================================================
-
-// Tamaño de cada celda del grid (en píxeles)
-const int GRID_SIZE = 20;
-
-// Resoluciones base (sin panel lateral)
-const int BASE_WINDOW_WIDTH = 800;
-const int BASE_WINDOW_HEIGHT = 600;
-
-// Ancho del panel lateral con información
-const int PANEL_WIDTH = 280;
-
-// ============================================================
-// VARIABLES GLOBALES DE PANTALLA
-// ============================================================
-
-// Dimensiones de la ventana de juego (cambian según resolución)
-int WINDOW_WIDTH = 800;
-int WINDOW_HEIGHT = 600;
-
-// Ancho total (juego + panel)
-int SCREEN_WIDTH = 1080;
-int SCREEN_HEIGHT = 720;
-
-// Factores de escala para adaptarse a diferentes resoluciones
-float SCALE_X = 1.0f;
-float SCALE_Y = 1.0f;
+#include <cstring>            // strlen (cartel de avance rápido)
+#include <algorithm>          // min, max
 
 // Textura global para fondos
 sf::Texture tex;
@@ -55,7 +38,7 @@ sf::Texture tex;
 sf::Music* backgroundMusic = nullptr;
 
 // ============================================================
-// ENUMERACIONES - Tipos de estados y power-ups
+// ENUMERACIONES - Estados de la aplicación
 // ============================================================
 
 // Estados principales del juego
@@ -63,76 +46,11 @@ enum GameState_Type {
     MENU,        // Menú principal
     PLAYING,     // Jugando
     RULES,       // Pantalla de reglas
-    GAME_OVER    // Pantalla de fin de juego
-};
-
-// Tipos de power-ups disponibles
-enum PowerUpType {
-    WALL_PASS,           // Permite atravesar paredes (10s)
-    DOUBLE_SCORE,        // Duplica puntos (10s)
-    MAGNET,              // Atrae manzanas hacia la serpiente (10s)
-    OBSTACLE_DESTROYER   // Destruye todos los obstáculos (instantáneo)
-};
-
-// ============================================================
-// ESTRUCTURAS DE DATOS
-// ============================================================
-
-// Representa un segmento de la serpiente
-struct SnakeSegment {
-    int x, y;  // Posición en el grid
-    
-    SnakeSegment(int x = 0, int y = 0) : x(x), y(y) {}
-    
-    // Compara si dos segmentos están en la misma posición
-    bool operator==(const SnakeSegment& other) const {
-        return x == other.x && y == other.y;
-    }
-};
-
-// Representa una manzana/bloque para comer
-struct Block {
-    int x, y;           // Posición en píxeles
-    int width, height;  // Dimensiones
-    
-    Block(int x, int y, int width = GRID_SIZE, int height = GRID_SIZE) 
-        : x(x), y(y), width(width), height(height) {}
-};
-
-// Representa un power-up especial
-struct PowerUp {
-    int x, y;           // Posición en píxeles
-    PowerUpType type;   // Tipo de poder
-    int width, height;  // Dimensiones
-    
-    PowerUp(int x, int y, PowerUpType type) 
-        : x(x), y(y), type(type), width(GRID_SIZE), height(GRID_SIZE) {}
-};
-
-// Representa un obstáculo en el mapa
-struct Obstacle {
-    int x, y;           // Posición en píxeles
-    int width, height;  // Dimensiones
-    
-    Obstacle(int x, int y) 
-        : x(x), y(y), width(GRID_SIZE), height(GRID_SIZE) {}
+    GAME_OVER,   // Pantalla de fin de juego
+    DEMO,        // Demostración con piloto automático (menú sin actividad)
+    REPLAY       // Repetición de una partida grabada
 };
 
-// ============================================================
-// FUNCIÓN DE CÁLCULO DE ESCALA
-// ============================================================
-
-// Calcula los factores de escala según la resolución de pantalla
-void calculateScaling() {
-    // Ancho total = ancho del juego + ancho del panel
-    SCREEN_WIDTH = WINDOW_WIDTH + PANEL_WIDTH;
-    SCREEN_HEIGHT = WINDOW_HEIGHT;
-    
-    // Factores de escala para adaptarse a diferentes resoluciones
-    SCALE_X = (float)WINDOW_WIDTH / BASE_WINDOW_WIDTH;
-    SCALE_Y = (float)WINDOW_HEIGHT / BASE_WINDOW_HEIGHT;
-}
-
 // ============================================================
 // CLASE: MENÚ PRINCIPAL
 // ============================================================
@@ -151,6 +69,13 @@ public:
     sf::Texture texExitButton;      // Textura del botón "SALIR"
     sf::Sprite sprExitButton;       // Sprite del botón "SALIR"
     
+    // ========== FORMAS REUTILIZABLES ==========
+    // Se configuran una sola vez en el constructor para no reconstruirlas en cada draw()
+    sf::RectangleShape background;      // Fondo con la textura del menú
+    sf::RectangleShape titleBg;         // Caja oscura detrás del título
+    sf::RectangleShape highlightBorder; // Borde de la opción seleccionada
+    sf::Sprite* sprites[3];             // Botones en orden (Iniciar, Reglas, Salir)
+    
     // ========== CONSTRUCTOR ==========
     // Carga las texturas y configura los sprites
     Menu() {
@@ -164,6 +89,28 @@ public:
         sprRulesButton.setTexture(texRulesButton);
         sprExitButton.setTexture(texExitButton);
         
+        sprites[0] = &sprInitButton;
+        sprites[1] = &sprRulesButton;
+        sprites[2] = &sprExitButton;
+        
+        // Fondo con la textura cargada
+        background.setSize(sf::Vector2f(SCREEN_WIDTH, SCREEN_HEIGHT));
+        background.setPosition(0, 0);
+        background.setTexture(&tex);
+        
+        // Caja oscura sobre el título para mejor legibilidad
+        titleBg.setSize(sf::Vector2f(SCREEN_WIDTH, 120));
+        titleBg.setPosition(0, 40);
+        titleBg.setFillColor(sf::Color(0, 0, 0, 200));
+        
+        // Borde blanco de resaltado (se reposiciona sobre el botón seleccionado)
+        float buttonWidth = sprInitButton.getLocalBounds().width;
+        float buttonHeight = sprInitButton.getLocalBounds().height;
+        highlightBorder.setSize(sf::Vector2f(buttonWidth * 0.10f, buttonHeight * 0.10f));
+        highlightBorder.setFillColor(sf::Color::Transparent);
+        highlightBorder.setOutlineColor(sf::Color::White);
+        highlightBorder.setOutlineThickness(3);
+        
         // Posicionar los botones en el menú (centrados horizontalmente, espaciados verticalmente)
         // El posicionamiento se hace en el método draw() para adaptarse mejor a la pantalla
     }
@@ -180,21 +127,13 @@ public:
         }
     }
     
-    // Dibuja el menú principal en pantalla
-    void draw(sf::RenderWindow& window) {
+    // Dibuja el menú principal en pantalla (ventana o textura de caché)
+    void draw(sf::RenderTarget& window) {
         // Limpia la pantalla
         window.clear(sf::Color::Black);
         
-        // Dibuja el fondo con la textura cargada
-        sf::RectangleShape background(sf::Vector2f(SCREEN_WIDTH, SCREEN_HEIGHT));
-        background.setPosition(0, 0);
-        background.setTexture(&tex);
+        // Dibuja el fondo y la caja del título
         window.draw(background);
-        
-        // Caja oscura sobre el título para mejor legibilidad
-        sf::RectangleShape titleBg(sf::Vector2f(SCREEN_WIDTH, 120));
-        titleBg.setPosition(0, 40);
-        titleBg.setFillColor(sf::Color(0, 0, 0, 200));
         window.draw(titleBg);
         
         // ========== POSICIONAMIENTO Y DIBUJO DE BOTONES ==========
@@ -202,9 +141,6 @@ public:
         float buttonWidth = sprInitButton.getLocalBounds().width;
         float buttonHeight = sprInitButton.getLocalBounds().height;
         
-        // Array de sprites para facilitar el manejo
-        std::vector<sf::Sprite*> sprites = {&sprInitButton, &sprRulesButton, &sprExitButton};
-        
         // Dibuja cada botón del menú
         for (int i = 0; i < 3; i++) {
             // Posicionar el botón (centrado horizontalmente)
@@ -220,11 +156,7 @@ public:
                 sprites[i]->setColor(sf::Color::White);
                 
                 // Dibujar un borde blanco de resaltado alrededor del botón
-                sf::RectangleShape highlightBorder(sf::Vector2f(buttonWidth * 0.10f, buttonHeight * 0.10f));
                 highlightBorder.setPosition(posX - (buttonWidth * 0.025f), posY - (buttonHeight * 0.025f));
-                highlightBorder.setFillColor(sf::Color::Transparent);
-                highlightBorder.setOutlineColor(sf::Color::White);
-                highlightBorder.setOutlineThickness(3);
                 window.draw(highlightBorder);
             } 
             // Si no está seleccionado, mostrar con opacidad normal
@@ -250,686 +182,717 @@ public:
 
 class Rules {
 public:
-    // ========== TEXTURAS Y SPRITES ==========
-    sf::Texture texRulesImage;      // Textura de la imagen de reglas
-    sf::Sprite sprRulesImage;       // Sprite de la imagen de reglas
+    // ========== IMÁGENES ==========
+    Picture rulesImage;             // Imagen de reglas
+    float imageScaleX = 1, imageScaleY = 1;
     
     // ========== CONSTRUCTOR ==========
     // Carga la imagen de reglas
     Rules() {
-        // Cargar textura de la imagen de reglas
-        if (!texRulesImage.loadFromFile("assets/images/reglas.png")) {
+        // Cargar la imagen de reglas
+        if (!rulesImage.loadFromFile("assets/images/reglas.png")) {
             std::cerr << "Error: No se pudo cargar la imagen de reglas (reglas.png)" << std::endl;
+            return;
         }
         
-        // Asignar textura al sprite
-        sprRulesImage.setTexture(texRulesImage);
-        
         // Escalar la imagen al tamaño de la pantalla del juego (sin panel)
-        float scaleX = (float)WINDOW_WIDTH / texRulesImage.getSize().x;
-        float scaleY = (float)WINDOW_HEIGHT / texRulesImage.getSize().y;
-        sprRulesImage.setScale(scaleX, scaleY);
-        sprRulesImage.setPosition(0, 0);
+        imageScaleX = (float)WINDOW_WIDTH / rulesImage.getSize().x;
+        imageScaleY = (float)WINDOW_HEIGHT / rulesImage.getSize().y;
     }
     
     // Dibuja la pantalla de reglas
-    void draw(sf::RenderWindow& window) {
+    void draw(Renderer& renderer) {
         // Limpia la pantalla
-        window.clear(sf::Color::Black);
+        renderer.clear(sf::Color::Black);
         
         // Dibuja la imagen de reglas escalada al tamaño del fondo
-        window.draw(sprRulesImage);
+        renderer.drawPicture(rulesImage, 0, 0, imageScaleX, imageScaleY);
     }
 };
 
-// ==========================================
-// CLASE GameState
-// ==========================================
-// Gestiona el estado completo del juego mientras está en ejecución.
-// Incluye:
-// - Movimiento de la serpiente
-// - Generación de bloques, obstáculos y power-ups
-// - Detección de colisiones
-// - Sistema de puntuación
-// - Manejo de power-ups activos
-class GameState {
+// ========== PRESETS DE TABLERO ==========
+// Se instancian aquí para que todos los presets compilen siempre
+template class BasicGameState<20, 15>;
+template class BasicGameState<40, 30>;
+template class BasicGameState<64, 48>;
+
+class GameOverMenu {
 public:
-    // ========== DATOS DEL JUEGO ==========
-    std::vector<SnakeSegment> snake;        // Segmentos que forman el cuerpo de la serpiente
-    std::vector<Block> blocks;              // Bloques/manzanas a comer
-    std::vector<PowerUp> powerUps;          // Power-ups en el mapa
-    std::vector<Obstacle> obstacles;        // Obstáculos que causan game over
-    
-    // ========== PUNTUACIÓN Y ESTADO GENERAL ==========
-    int score = 0;                          // Puntos acumulados (10 por manzana, 20 si double score activo)
-    int applesEaten = 0;                    // Contador de manzanas comidas (afecta velocidad)
-    bool gameOver = false;                  // Flag de fin de juego
-    
-    // ========== MOVIMIENTO Y DIRECCIÓN ==========
-    int direction = 1;                      // Dirección actual (0=arriba, 1=derecha, 2=abajo, 3=izquierda)
-    int nextDirection = 1;                  // Siguiente dirección (se aplica en el siguiente frame)
-    float moveCounter = 0;                  // Contador para controlar velocidad (incrementa cada frame)
-    int moveDelay = 10;                     // Delay entre movimientos (afectado por velocidad)
-    
-    // ========== SPAWN DE BLOQUES ==========
-    float blockSpawnTimer = 0;              // Timer para spawn de manzanas
-    float blockSpawnDelay = 5.0f;           // Intervalo entre spawns (5 segundos)
-    
-    // ========== SPAWN DE POWER-UPS ==========
-    float powerUpSpawnTimer = 0;            // Timer para spawn de power-ups
-    float powerUpSpawnDelay = 15.0f;        // Intervalo entre spawns (15 segundos)
-    
-    // ========== SPAWN DE OBSTÁCULOS ==========
-    float obstacleSpawnTimer = 0;           // Timer para spawn de obstáculos
-    float obstacleSpawnDelay = 4.0f;        // Intervalo entre spawns (4 segundos)
-    
-    // ========== SPAWN DE OBSTACLE DESTROYER ==========
-    float obstacleDestroyerSpawnTimer = 0; // Timer para spawn de destructor
-    float obstacleDestroyerSpawnDelay = 30.0f; // Aparece cada 30 segundos (solo si 15+ obstáculos)
+    bool isVisible = false;
+    int finalScore = 0;
+    int finalApplesEaten = 0;
+    int selectedOption = 0;  // 0 = Reiniciar, 1 = Salir
     
-    // ========== POWER-UPS ACTIVOS ==========
-    bool wallPassActive = false;            // Si verdadero, la serpiente puede atravesar paredes
-    float wallPassTimer = 0;                // Tiempo restante del power-up WALL_PASS
+    // ========== IMÁGENES Y SPRITES ==========
+    Picture loserImage;             // Imagen "loser.png"
     
-    bool doubleScoreActive = false;         // Si verdadero, cada manzana vale 20 puntos (en lugar de 10)
-    float doubleScoreTimer = 0;             // Tiempo restante del power-up DOUBLE_SCORE
+    sf::Texture texRestartButton;   // Textura del botón "REINICIAR"
+    sf::Sprite sprRestartButton;    // Sprite del botón "REINICIAR"
     
-    bool magnetActive = false;              // Si verdadero, las manzanas se atraen hacia la serpiente
-    float magnetTimer = 0;                  // Tiempo restante del power-up MAGNET
+    sf::Texture texExitButton;      // Textura del botón "SALIR"
+    sf::Sprite sprExitButton;       // Sprite del botón "SALIR"
     
-    // ========== OTROS ==========
-    float gameTimer = 0;                    // Timer global del juego
-    int speedLevel = 1;                     // Nivel de velocidad (aumenta con manzanas comidas)
+    // ========== RÉCORDS ==========
+    // Tabla del SessionStore en el panel lateral (se arma en show())
+    static constexpr int RECORDS_SHOWN = 5;
+    HudBatch records;
+    int recordsBackground, recordsTitle, recordsRows[RECORDS_SHOWN], recordsBest, recordsGames;
     
     // ========== CONSTRUCTOR ==========
-    // Inicializa el juego con la serpiente en el centro de la pantalla
-    GameState() {
-        snake.push_back(SnakeSegment(WINDOW_WIDTH / (2 * GRID_SIZE), WINDOW_HEIGHT / (2 * GRID_SIZE)));
-    }
-    
-    // ========== MANEJO DE ENTRADA ==========
-    // Actualiza la dirección de movimiento según la entrada del usuario
-    // Evita que la serpiente se doble sobre sí misma (no puede ir en dirección opuesta)
-    void handleInput(sf::Keyboard::Scancode key) {
-        if (key == sf::Keyboard::Scan::Up && direction != 2) nextDirection = 0;        // Arriba (no desde abajo)
-        else if (key == sf::Keyboard::Scan::Right && direction != 3) nextDirection = 1; // Derecha (no desde izquierda)
-        else if (key == sf::Keyboard::Scan::Down && direction != 0) nextDirection = 2;  // Abajo (no desde arriba)
-        else if (key == sf::Keyboard::Scan::Left && direction != 1) nextDirection = 3;  // Izquierda (no desde derecha)
-    }
-    // ========== ACTUALIZACIÓN DEL JUEGO ==========
-    // Se ejecuta cada frame (60 veces por segundo)
-    // Maneja: power-ups, timers de spawn, movimiento de la serpiente, colisiones
-    void update(float deltaTime) {
-        if (gameOver) return;  // Si el juego terminó, no actualizar nada
+    // Carga las texturas y configura los sprites
+    GameOverMenu() {
+        recordsBackground = records.addRect();
+        recordsTitle = records.addText(10);
+        for (int& row : recordsRows) row = records.addText(20);
+        recordsBest = records.addText(20);
+        recordsGames = records.addText(20);
+        
+        // Cargar la imagen loser.png
+        if (!loserImage.loadFromFile("assets/images/loser.png")) {
+            std::cerr << "Error: No se pudo cargar la imagen loser.png" << std::endl;
+        }
         
-        gameTimer += deltaTime;  // Incrementar timer global del juego
+        // Cargar texturas desde archivos
+        texRestartButton.loadFromFile("assets/images/Boton.iniciar.png");
+        texExitButton.loadFromFile("assets/images/Boton.salir.png");
         
-        // ========== CÁLCULO DE VELOCIDAD ==========
-        // Cada 10 manzanas comidas, la serpiente se mueve más rápido
-        speedLevel = 1 + (applesEaten / 10);
-        // Cada nivel de velocidad reduce el delay en 0.5 unidades
-        moveDelay = 10 - (speedLevel - 1) * 0.5f;
-        if (moveDelay < 2) moveDelay = 2;  // Límite mínimo de velocidad
+        // Asignar texturas a sprites
+        sprRestartButton.setTexture(texRestartButton);
+        sprExitButton.setTexture(texExitButton);
+    }
+    
+    void show(int score, int applesEaten, const SessionStore& sessions) {
+        // Mostrar la pantalla de game over con los scores finales
+        isVisible = true;
+        finalScore = score;
+        finalApplesEaten = applesEaten;
+        selectedOption = 1;  // Seleccionar solo la opción SALIR
+        showRecords(sessions);
         
-        // ========== POWER-UP: WALL PASS ==========
-        // Permite a la serpiente atravesar las paredes durante 10 segundos
-        if (wallPassActive) {
-            wallPassTimer += deltaTime;
-            if (wallPassTimer >= 10.0f) {
-                wallPassActive = false;
-                wallPassTimer = 0;
-            }
+        // Escalar la imagen loser.png para que cubra el área de juego
+        // (se calcula aquí una sola vez, no en cada frame)
+        sf::Vector2u size = loserImage.getSize();
+        if (size.x > 0 && size.y > 0) {
+            imageScaleX = (float)WINDOW_WIDTH / size.x;
+            imageScaleY = (float)WINDOW_HEIGHT / size.y;
         }
+    }
+    
+    // Maneja entrada del usuario en la pantalla de game over
+    void handleInput(sf::Keyboard::Scancode key) {
+        // Solo hay una opción: SALIR
+        selectedOption = 1;
+    }
+    
+    // Dibuja la pantalla de game over con la imagen loser.png
+    void draw(Renderer& renderer) {
+        if (!isVisible) return;  // No dibujar si no está visible
         
-        // ========== POWER-UP: DOUBLE SCORE ==========
-        // Duplica los puntos obtenidos (20 por manzana en lugar de 10) por 10 segundos
-        if (doubleScoreActive) {
-            doubleScoreTimer += deltaTime;
-            if (doubleScoreTimer >= 10.0f) {
-                doubleScoreActive = false;
-                doubleScoreTimer = 0;
+        // Dibujar la imagen loser.png y el fondo oscuro semitransparente del panel lateral
+        renderer.drawPicture(loserImage, 0, 0, imageScaleX, imageScaleY);
+        renderer.fillRect(WINDOW_WIDTH * SCALE_X, 0, PANEL_WIDTH, SCREEN_HEIGHT, sf::Color(0, 0, 0, 150));
+        records.draw(renderer);
+    }
+    
+private:
+    float imageScaleX = 1, imageScaleY = 1;  // Escala de loser.png (calculada en show())
+    
+    // Mejores puntuaciones (la de esta partida en amarillo), récord y
+    // partidas jugadas. La partida recién terminada ya se encoló al morir;
+    // si el hilo escritor todavía no la procesó, aparece en la próxima.
+    void showRecords(const SessionStore& sessions) {
+        std::vector<SessionRecord> top = sessions.topScores();
+        float x = WINDOW_WIDTH * SCALE_X + 15;
+        float y = SCREEN_HEIGHT * 0.45f;
+        records.setRect(recordsBackground, x - 10, y - 10, PANEL_WIDTH - 10, 22.0f * (RECORDS_SHOWN + 4) + 10,
+                        sf::Color(0, 0, 0, 220));
+        records.setText(recordsTitle, "RECORDS", x, y, 2, sf::Color(200, 200, 200));
+        
+        char text[HudBatch::MAX_TEXT + 1];
+        bool highlighted = false;
+        for (int i = 0; i < RECORDS_SHOWN; i++) {
+            float rowY = y + 22.0f * (i + 1.5f);
+            if (i >= (int)top.size()) {
+                records.hide(recordsRows[i]);
+                continue;
             }
+            bool current = !highlighted && top[i].score == finalScore && top[i].applesEaten == finalApplesEaten;
+            highlighted = highlighted || current;
+            std::snprintf(text, sizeof(text), "%2d. %d", i + 1, top[i].score);
+            records.setText(recordsRows[i], text, x, rowY, 2, current ? sf::Color::Yellow : sf::Color::White);
+        }
+        std::snprintf(text, sizeof(text), "BEST %d", sessions.bestScore());
+        records.setText(recordsBest, text, x, y + 22.0f * (RECORDS_SHOWN + 2), 2, sf::Color(255, 165, 0));
+        std::snprintf(text, sizeof(text), "GAMES %llu", static_cast<unsigned long long>(sessions.sessionCount()));
+        records.setText(recordsGames, text, x, y + 22.0f * (RECORDS_SHOWN + 3), 2, sf::Color(200, 200, 200));
+    }
+};
+
+// ============================================================
+// CLASE: CACHÉ DE PANTALLAS ESTÁTICAS
+// ============================================================
+// El menú, las reglas y el overlay de game over no cambian mientras
+// no llegue una entrada. Se renderizan una sola vez en una textura y
+// el bucle principal se bloquea en waitEvent() hasta el siguiente evento,
+// en lugar de redibujar todo a 60 fps sin necesidad.
+class StaticScreenCache {
+public:
+    sf::RenderTexture target;   // Textura donde se renderiza la pantalla estática
+    sf::Sprite sprite;          // Sprite para copiar la textura a la ventana
+    bool available = false;     // false si no se pudo crear la textura (se dibuja directo)
+    bool dirty = true;          // El contenido cambió: hay que volver a renderizarlo
+    bool pendingPresent = true; // La ventana necesita mostrar la caché otra vez
+    
+    StaticScreenCache() {
+        available = target.create(SCREEN_WIDTH, SCREEN_HEIGHT);
+        if (available) {
+            sprite.setTexture(target.getTexture());
+        } else {
+            std::cerr << "Aviso: sin caché de pantallas estáticas (RenderTexture no disponible)" << std::endl;
         }
-        
-        // ========== POWER-UP: MAGNET ==========
-        // Las manzanas se atraen hacia la serpiente durante 10 segundos
-        if (magnetActive) {
-            magnetTimer += deltaTime;
-            if (magnetTimer >= 10.0f) {
-                magnetActive = false;
-                magnetTimer = 0;
-            }
+    }
+    
+    // El contenido cambió (entrada del usuario o cambio de estado)
+    void invalidate() {
+        dirty = true;
+        pendingPresent = true;
+    }
+    
+    // Solo hay que volver a mostrar lo que ya está en la caché (p.ej. al recuperar el foco)
+    void requestPresent() {
+        pendingPresent = true;
+        if (!available) dirty = true;  // Sin caché no hay nada que copiar: redibujar
+    }
+};
+
+// ========== ESPERA CON PLAZO ==========
+// waitEvent() que se rinde al cumplirse 'timeout' (SFML 2 no lo tiene):
+// espera igual que el waitEvent() de SFML, consultando en pasos de 10 ms,
+// pero vuelve a más tardar en el plazo. false si no llegó ningún evento.
+bool waitEventFor(sf::RenderWindow& window, sf::Event& event, sf::Time timeout) {
+    sf::Clock waited;
+    while (!window.pollEvent(event)) {
+        sf::Time left = timeout - waited.getElapsedTime();
+        if (left <= sf::Time::Zero) return false;
+        sf::sleep(std::min(left, sf::milliseconds(10)));
+    }
+    return true;
+}
+
+// ========== CACHÉ DEL TABLERO ==========
+// Mientras se juega, el tablero vive en una textura que se conserva entre
+// frames: GameState::paintBoard() solo repinta las celdas que cambiaron y
+// cada frame se copia a la ventana con un sprite.
+class PlayfieldCache {
+public:
+    sf::RenderTexture target;   // Tablero y línea divisoria
+    sf::Sprite sprite;          // Copia la textura a la ventana
+    bool available = false;     // false si no se pudo crear (se dibuja con draw())
+    
+    PlayfieldCache() {
+        available = target.create(static_cast<unsigned>(WINDOW_WIDTH * SCALE_X) + 2,
+                                  static_cast<unsigned>(WINDOW_HEIGHT * SCALE_Y));
+        if (available) {
+            sprite.setTexture(target.getTexture());
+        } else {
+            std::cerr << "Aviso: sin caché del tablero (RenderTexture no disponible)" << std::endl;
         }
-        
-        // Actualizar dirección a la siguiente entrada del usuario
-        direction = nextDirection;
-        
-        // ========== MAGNET LOGIC ==========
-        // Si el power-up MAGNET está activo, atraer los bloques hacia la cabeza
-        if (magnetActive && !snake.empty()) {
-            SnakeSegment head = snake[0];  // Posición de la cabeza
-            std::vector<int> blocksToRemove;
-            for (int i = 0; i < blocks.size(); i++) {
-                auto& block = blocks[i];
-                int blockGridX = block.x / GRID_SIZE;
-                int blockGridY = block.y / GRID_SIZE;
+    }
+};
 
-                // Atraer el bloque hacia la cabeza (mover en dirección X)
-                if (blockGridX < head.x) blockGridX++;
-                else if (blockGridX > head.x) blockGridX--;
+// ========== CARTEL DE DEMOSTRACIÓN / REPETICIÓN ==========
+// Esquina superior del tablero: modo y multiplicador de avance rápido
+// ("REPLAY 8x/20x" si el presupuesto del frame no deja llegar al elegido)
+class PlaybackBanner {
+public:
+    PlaybackBanner() {
+        background = hud.addRect();
+        label = hud.addText(HudBatch::MAX_TEXT);
+    }
+    
+    void draw(Renderer& renderer, const char* mode, const FastForward& turbo, bool ended) {
+        char text[HudBatch::MAX_TEXT + 1];
+        if (ended) std::snprintf(text, sizeof(text), "%s END", mode);
+        else if (turbo.limited()) std::snprintf(text, sizeof(text), "%s %dx/%dx", mode, turbo.effective(), turbo.requested());
+        else std::snprintf(text, sizeof(text), "%s %dx", mode, turbo.requested());
+        float width = std::strlen(text) * HudFont::CELL_W * 2 + 12;
+        hud.setRect(background, 8, 8, width, 26, sf::Color(0, 0, 0, 180));
+        hud.setText(label, text, 14, 14, 2, sf::Color::White);
+        hud.draw(renderer);
+    }
+    
+private:
+    HudBatch hud;
+    int background, label;
+};
+
+// ============================================================
+// REGISTRO DE PARTIDAS
+// ============================================================
+
+// Construye el registro de una partida terminada para el SessionStore
+template <class Game>
+SessionRecord makeSessionRecord(const Game& game, SessionEndCause cause) {
+    SessionRecord record;
+    record.score = game.score;
+    record.applesEaten = game.applesEaten;
+    record.durationMs = static_cast<std::uint32_t>(game.gameTimer * 1000.0f);
+    record.seed = game.seed;
+    record.timestamp = static_cast<std::uint32_t>(time(0));
+    record.cause = cause;
+    return record;
+}
 
-                if (blockGridY < head.y) blockGridY++;
-                else if (blockGridY > head.y) blockGridY--;
+// Traduce la causa del game over al valor que se guarda en el log
+SessionEndCause endCauseFor(DeathCause cause) {
+    switch (cause) {
+        case DEATH_WALL: return END_WALL;
+        case DEATH_SELF: return END_SELF;
+        case DEATH_OBSTACLE: return END_OBSTACLE;
+        default: return END_UNKNOWN;
+    }
+}
+
+// La repetición se grabó en el tablero de este preset
+template <class Game>
+bool replayFits(const ReplayRecording& replay) {
+    return replay.cols == Game::BOARD_COLS && replay.rows == Game::BOARD_ROWS;
+}
 
-                block.x = blockGridX * GRID_SIZE;
-                block.y = blockGridY * GRID_SIZE;
+// ============================================================
+// EFECTOS VISUALES
+// ============================================================
 
-                // Si el bloque llega a la cabeza con MAGNET, comerlo automáticamente
-                if (block.x == head.x * GRID_SIZE && block.y == head.y * GRID_SIZE) {
-                    int points = doubleScoreActive ? 20 : 10;
-                    score += points;
-                    applesEaten++;
-                    blocksToRemove.push_back(i);
+// Convierte los eventos del último tick en ráfagas de partículas
+template <class Game>
+void spawnEffects(ParticleSystem& particles, const Game& game) {
+    float cellW = WINDOW_WIDTH * SCALE_X / Game::BOARD_COLS;
+    float cellH = WINDOW_HEIGHT * SCALE_Y / Game::BOARD_ROWS;
+    // OBSTACLE_DESTROYER: hasta MAX_OBSTACLES ráfagas en un tick; se
+    // reparten la mitad del pool para que todos los obstáculos tengan la suya
+    int destroyed = 0;
+    for (int i = 0; i < game.eventCount; i++) destroyed += game.events[i].type == EVENT_OBSTACLE_DESTROYED;
+    int destroyedBurst = ParticleSystem::perBurst(destroyed, 400);
+    for (int i = 0; i < game.eventCount; i++) {
+        const GameEvent& event = game.events[i];
+        float x = (event.x + 0.5f) * cellW;
+        float y = (event.y + 0.5f) * cellH;
+        switch (event.type) {
+            case EVENT_APPLE_EATEN:
+                particles.burst(x, y, 80, 160.0f, sf::Color::Red, 0.6f);
+                break;
+            case EVENT_MAGNET_PICKUP:
+                particles.burst(x, y, 40, 120.0f, sf::Color(255, 165, 0), 0.5f);
+                break;
+            case EVENT_POWERUP_TAKEN:
+                particles.burst(x, y, 150, 220.0f, Game::powerUpDef(event.detail).color, 0.8f);
+                break;
+            case EVENT_OBSTACLE_DESTROYED:
+                // Hasta 400 por obstáculo (3/4 cian, 1/4 blancas)
+                particles.burst(x, y, destroyedBurst - destroyedBurst / 4, 260.0f, sf::Color::Cyan, 1.0f);
+                particles.burst(x, y, destroyedBurst / 4, 140.0f, sf::Color::White, 0.7f);
+                break;
+            case EVENT_DEATH:
+                particles.burst(x, y, 1500, 320.0f, sf::Color::Green, 1.2f);
+                for (const auto& segment : game.snake) {
+                    particles.burst((segment.x + 0.5f) * cellW, (segment.y + 0.5f) * cellH,
+                                    12, 90.0f, sf::Color(0, 160, 0), 0.9f);
                 }
-            }
-            // Remover bloques comidos (en orden inverso para evitar cambios de índice)
-            for (int i = blocksToRemove.size() - 1; i >= 0; i--) {
-                blocks.erase(blocks.begin() + blocksToRemove[i]);
-            }
+                break;
         }
-        
-        // Incrementar el contador de movimiento según el nivel de velocidad
-        moveCounter += speedLevel;
-        
-        // ========== SPAWN DE ELEMENTOS (INDEPENDIENTE DEL MOVIMIENTO) ==========
-        // IMPORTANTE: Los spawns se ejecutan cada frame (60 veces/segundo)
-        // NO afectan la velocidad de movimiento de la serpiente
-        
-        // SPAWN: OBSTACLE_DESTROYER (Power-up blanco que destruye todos los obstáculos)
-        // Solo aparece cuando hay 15 o más obstáculos, cada 30 segundos
-        if (obstacles.size() >= 15) {
-            obstacleDestroyerSpawnTimer += 0.016f;  // Incrementar cada frame
-            if (obstacleDestroyerSpawnTimer >= obstacleDestroyerSpawnDelay) {
-                int randomX = rand() % (WINDOW_WIDTH / GRID_SIZE);
-                int randomY = rand() % (WINDOW_HEIGHT / GRID_SIZE);
-                bool validPos = true;  // Flag para validar que la posición no esté ocupada
-                
-                // Verificar que no colisione con la serpiente
-                for (const auto& segment : snake) {
-                    if (segment.x == randomX && segment.y == randomY) {
-                        validPos = false;
-                        break;
-                    }
-                }
-                
-                // Si la posición es válida, crear el power-up
-                if (validPos) {
-                    powerUps.push_back(PowerUp(randomX * GRID_SIZE, randomY * GRID_SIZE, OBSTACLE_DESTROYER));
-                }
-                // Resetear el timer después de spawning
-                obstacleDestroyerSpawnTimer = 0;
-            }
+    }
+}
+
+// ============================================================
+// BUCLE PRINCIPAL DEL JUEGO
+// ============================================================
+const float ATTRACT_DELAY_SECONDS = 20.0f;         // Menú sin teclas antes de la demostración
+const float ATTRACT_DEMO_SECONDS = 60.0f;          // Duración de la demostración (después, el menú)
+const char* const LAST_REPLAY_PATH = "scores/last.replay";
+
+// Plantilla sobre el preset de tablero elegido en la línea de comandos
+// 'gridRender' dibuja el tablero como textura de un texel por celda;
+// con 'spectator' se publica el estado después de cada tick y con
+// 'replayFile' se empieza viendo esa repetición (--replay)
+template <class Game>
+void runGame(sf::RenderWindow& window, SessionStore& sessions, bool gridRender, SpectatorFeed* spectator,
+             const ReplayRecording* replayFile) {
+    // ========== INICIALIZACIÓN DE ESTADOS Y OBJETOS ==========
+    GameState_Type gameState = MENU;  // Estado inicial es el menú
+    Menu menu;                        // Instancia del menú principal
+    Rules rules;                      // Instancia de la pantalla de reglas
+    Game game;                        // Instancia del juego
+    GameOverMenu gameOverMenu;        // Instancia del menú de game over
+    StaticScreenCache screenCache;    // Caché de menú, reglas y game over
+    ParticleSystem particles;         // Efectos (pool reservado una sola vez)
+    SfmlRenderer windowRenderer(window);              // Dibujo directo en la ventana
+    SfmlRenderer cacheRenderer(screenCache.target);   // Dibujo en la caché de pantallas
+    PlayfieldCache playfield;         // Tablero persistente (solo celdas cambiadas)
+    SfmlRenderer playfieldRenderer(playfield.target);
+    BoardTexture boardTexture(Game::BOARD_COLS, Game::BOARD_ROWS);  // Solo con --render=grid
+    int steadyFrames = 0;             // Frames seguidos jugando (para AllocCheck)
+    ReplayRecording recording;        // Partida del jugador (la última, al terminar)
+    ReplayPlayer replay;              // Repetición que se está viendo
+    FastForward turbo;                // Ticks por frame en DEMO y REPLAY (+/-)
+    PlaybackBanner banner;            // Modo y multiplicador sobre el tablero
+    sf::Clock menuIdle;               // Tiempo sin teclas (demostración en el menú)
+    sf::Clock demoTime;               // Tiempo desde que empezó la demostración
+    bool demoShown = false;           // Ya hubo demostración desde la última tecla
+    
+    if (replayFile) {
+        gameState = REPLAY;
+        replay.start(*replayFile, game);
+    }
+    
+    // La partida del jugador terminó: guardar su repetición
+    auto saveRecording = [&]() {
+        if (!recording.save(LAST_REPLAY_PATH)) {
+            std::cerr << "Aviso: no se pudo guardar la repetición en " << LAST_REPLAY_PATH << std::endl;
+        }
+    };
+    
+    // Pantallas que no cambian solas (DEMO y REPLAY se dibujan como una partida)
+    auto isStaticScreen = [&]() {
+        return (gameState != PLAYING && gameState != DEMO && gameState != REPLAY) || gameOverMenu.isVisible;
+    };
+    
+    // Tablero con el modo de dibujo elegido
+    auto drawBoard = [&](SfmlRenderer& renderer) {
+        if (gridRender) {
+            game.drawGrid(renderer, boardTexture);
+        } else if (playfield.available) {
+            if (game.paintBoard(playfieldRenderer)) playfield.target.display();
+            renderer.target().draw(playfield.sprite);
         } else {
-            // Si hay menos de 15 obstáculos, resetear el timer
-            obstacleDestroyerSpawnTimer = 0;
+            game.draw(renderer);
         }
+    };
+    
+    // ========== MANEJO DE EVENTOS ==========
+    // Procesa un evento de la ventana según el estado actual
+    auto handleEvent = [&](const sf::Event& event) {
+        if (event.type == sf::Event::Closed)
+            window.close();
         
-        // SPAWN: POWER-UPS NORMALES (cada 15 segundos)
-        // Puede generar: WALL_PASS (33%), DOUBLE_SCORE (33%), o MAGNET (33%)
-        powerUpSpawnTimer += 0.016f;
-        if (powerUpSpawnTimer >= powerUpSpawnDelay) {
-            int randomX = rand() % (WINDOW_WIDTH / GRID_SIZE);
-            int randomY = rand() % (WINDOW_HEIGHT / GRID_SIZE);
-            bool validPos = true;
-            
-            // Verificar que la posición no esté ocupada por la serpiente
-            for (const auto& segment : snake) {
-                if (segment.x == randomX && segment.y == randomY) {
-                    validPos = false;
-                    break;
-                }
-            }
-            
-            // Si la posición es válida, seleccionar tipo aleatorio y crear power-up
-            if (validPos) {
-                // Seleccionar tipo: 1/3 para cada poder
-                PowerUpType type = (rand() % 3 == 0) ? WALL_PASS : (rand() % 2 == 0) ? DOUBLE_SCORE : MAGNET;
-                powerUps.push_back(PowerUp(randomX * GRID_SIZE, randomY * GRID_SIZE, type));
-            }
-            // Resetear el timer
-            powerUpSpawnTimer = 0;
+        // Al recuperar el foco o cambiar de tamaño, volver a mostrar la caché
+        if (event.type == sf::Event::GainedFocus || event.type == sf::Event::Resized) {
+            screenCache.requestPresent();
         }
+        if (event.type == sf::Event::Resized) game.requestBoardRepaint();
         
-        // SPAWN: OBSTÁCULOS (cada 8 segundos)
-        // Los obstáculos causan game over si colisionan con la serpiente
-        // Máximo 20 obstáculos en pantalla
-        obstacleSpawnTimer += 0.016f;
-        if (obstacleSpawnTimer >= obstacleSpawnDelay) {
-            int randomX = rand() % (WINDOW_WIDTH / GRID_SIZE);
-            int randomY = rand() % (WINDOW_HEIGHT / GRID_SIZE);
-            bool validPos = true;
+        if (event.type == sf::Event::KeyPressed) {
+            // Cualquier tecla puede cambiar lo que muestra una pantalla estática
+            screenCache.invalidate();
+            menuIdle.restart();
+            demoShown = false;
             
-            // Verificar que no esté en la serpiente
-            for (const auto& segment : snake) {
-                if (segment.x == randomX && segment.y == randomY) {
-                    validPos = false;
-                    break;
+            // ========== AVANCE RÁPIDO (+/-) ==========
+            if (gameState == DEMO || gameState == REPLAY) {
+                sf::Keyboard::Scancode key = event.key.scancode;
+                if (key == sf::Keyboard::Scan::Equal || key == sf::Keyboard::Scan::NumpadPlus) {
+                    turbo.faster();
+                    return;
                 }
-            }
-            
-            // Solo crear si la posición es válida y no hay demasiados obstáculos
-            if (validPos && obstacles.size() < 30) {
-                obstacles.push_back(Obstacle(randomX * GRID_SIZE, randomY * GRID_SIZE));
-            }
-            // Resetear el timer
-            obstacleSpawnTimer = 0;
-        }
-        
-        // SPAWN: MANZANAS (cada 1 segundo)
-        // Las manzanas aumentan puntuación y velocidad
-        blockSpawnTimer += 0.016f;
-        if (blockSpawnTimer >= blockSpawnDelay) {
-            int randomX = rand() % (WINDOW_WIDTH / GRID_SIZE);
-            int randomY = rand() % (WINDOW_HEIGHT / GRID_SIZE);
-            
-            bool onSnake = false;
-            // Verificar que no esté en la serpiente
-            for (const auto& segment : snake) {
-                if (segment.x == randomX && segment.y == randomY) {
-                    onSnake = true;
-                    break;
+                if (key == sf::Keyboard::Scan::Hyphen || key == sf::Keyboard::Scan::NumpadMinus) {
+                    turbo.slower();
+                    return;
                 }
             }
             
-            // Si no está en la serpiente, crear la manzana
-            if (!onSnake) {
-                blocks.push_back(Block(randomX * GRID_SIZE, randomY * GRID_SIZE));
+            // ========== TECLA ESC: Regresar al menú ==========
+            if (event.key.scancode == sf::Keyboard::Scan::Escape) {
+                if (gameState == PLAYING || gameState == GAME_OVER) {
+                    // Abandonar una partida en curso también queda registrado
+                    if (gameState == PLAYING && !game.gameOver) {
+                        sessions.submit(makeSessionRecord(game, END_QUIT));
+                    }
+                    if (gameState == PLAYING && !gameOverMenu.isVisible) saveRecording();
+                    gameState = MENU;
+                    game.reset(static_cast<unsigned>(rand()));
+                    particles.clear();
+                    gameOverMenu.isVisible = false;
+                } else if (gameState == RULES) {
+                    gameState = MENU;
+                } else if (gameState == DEMO || gameState == REPLAY) {
+                    gameState = MENU;
+                    game.reset(static_cast<unsigned>(rand()));
+                    particles.clear();
+                } else {
+                    window.close();
+                }
             }
             
-            // Resetear el timer
-            blockSpawnTimer = 0;
-        }
-        
-        // ========== MOVIMIENTO DE LA SERPIENTE ==========
-        // IMPORTANTE: El movimiento SOLO ocurre cuando moveCounter >= moveDelay
-        // Los spawns (arriba) ocurren independientemente cada frame
-        // Esto permite que los power-ups aparezcan correctamente sin afectar velocidad
-        
-        if (moveCounter < moveDelay) {
-            return;  // Si no es tiempo de mover, salir de la función
-        }
-        moveCounter = 0;  // Resetear contador para próximo movimiento
-        
-        // ========== CÁLCULO DE NUEVA POSICIÓN DE CABEZA ==========
-        // Crear nueva cabeza basada en dirección actual
-        SnakeSegment head = snake[0];  // Copiar posición actual
-        if (direction == 0) head.y--;           // Arriba: decrementar Y
-        else if (direction == 1) head.x++;      // Derecha: incrementar X
-        else if (direction == 2) head.y++;      // Abajo: incrementar Y
-        else if (direction == 3) head.x--;      // Izquierda: decrementar X
-        
-        // ========== COLISIÓN: PAREDES ==========
-        // Verificar si la cabeza sale de los límites de pantalla
-        if (!wallPassActive) {
-            // Sin power-up: colisionar con paredes causa game over
-            if (head.x < 0 || head.x >= WINDOW_WIDTH / GRID_SIZE ||
-                head.y < 0 || head.y >= WINDOW_HEIGHT / GRID_SIZE) {
-                gameOver = true;
-                return;
-            }
-        } else {
-            // Con WALL_PASS: envolver a la posición opuesta (efecto de túnel)
-            if (head.x < 0) head.x = WINDOW_WIDTH / GRID_SIZE - 1;
-            else if (head.x >= WINDOW_WIDTH / GRID_SIZE) head.x = 0;
-            if (head.y < 0) head.y = WINDOW_HEIGHT / GRID_SIZE - 1;
-            else if (head.y >= WINDOW_HEIGHT / GRID_SIZE) head.y = 0;
-        }
-        
-        // ========== COLISIÓN: AUTO-COLISIÓN (SERPIENTE CONSIGO MISMA) ==========
-        // Verificar si la cabeza colisiona con algún segmento del cuerpo
-        for (const auto& segment : snake) {
-            if (head == segment) {
-                gameOver = true;
-                return;
-            }
-        }
-        
-        // ========== COLISIÓN: OBSTÁCULOS ==========
-        // Verificar si la cabeza colisiona con algún obstáculo
-        for (const auto& obstacle : obstacles) {
-            if (head.x * GRID_SIZE == obstacle.x && head.y * GRID_SIZE == obstacle.y) {
-                gameOver = true;
-                return;
-            }
-        }
-        
-        // ========== MOVIMIENTO: INSERTAR CABEZA ==========
-        // Agregar la nueva cabeza al inicio de la lista
-        snake.insert(snake.begin(), head);
-        
-        // ========== COMER: BLOQUES/MANZANAS ==========
-        // Verificar si la cabeza está en la posición de alguna manzana
-        bool ateBlock = false;  // Flag para saber si comió algo (decide si crece)
-        for (auto it = blocks.begin(); it != blocks.end(); ++it) {
-            if (head.x * GRID_SIZE == it->x && head.y * GRID_SIZE == it->y) {
-                // Calcular puntos (double si power-up activo)
-                int points = doubleScoreActive ? 20 : 10;
-                score += points;
-                applesEaten++;  // Incrementar contador (afecta velocidad)
-                blocks.erase(it);  // Remover la manzana
-                ateBlock = true;
-                break;
-            }
-        }
-        
-        // ========== COMER: POWER-UPS ==========
-        // Verificar si la cabeza está en la posición de algún power-up
-        for (auto it = powerUps.begin(); it != powerUps.end(); ++it) {
-            if (head.x * GRID_SIZE == it->x && head.y * GRID_SIZE == it->y) {
-                // Aplicar efecto según el tipo de power-up
-                if (it->type == WALL_PASS) {
-                    // WALL_PASS: Permite atravesar paredes por 10 segundos
-                    wallPassActive = true;
-                    wallPassTimer = 0;
-                } else if (it->type == DOUBLE_SCORE) {
-                    // DOUBLE_SCORE: Manzanas valen el doble (20 en lugar de 10) por 10 segundos
-                    doubleScoreActive = true;
-                    doubleScoreTimer = 0;
-                } else if (it->type == MAGNET) {
-                    // MAGNET: Atraer manzanas hacia la serpiente por 10 segundos
-                    magnetActive = true;
-                    magnetTimer = 0;
-                } else if (it->type == OBSTACLE_DESTROYER) {
-                    // OBSTACLE_DESTROYER: Eliminar TODOS los obstáculos y ganar 50 bonus
-                    obstacles.clear();  // Limpiar lista de obstáculos
-                    score += 50;  // Bonus de puntos
+            // ========== MANEJO DE ENTRADA POR ESTADO ==========
+            if (gameState == MENU) {
+                menu.handleInput(event.key.scancode);
+                
+                if (event.key.scancode == sf::Keyboard::Scan::Enter) {
+                    int option = menu.getSelectedOption();
+                    if (option == 0) {
+                        // Opción: INICIAR JUEGO
+                        gameState = PLAYING;
+                        game.reset(static_cast<unsigned>(rand()));
+                        recording.start(game);
+                        particles.clear();
+                        gameOverMenu.isVisible = false;
+                    } else if (option == 1) {
+                        // Opción: REGLAS
+                        gameState = RULES;
+                    } else if (option == 2) {
+                        // Opción: SALIR
+                        window.close();
+                    }
+                }
+            } else if (gameState == RULES) {
+                if (event.key.scancode == sf::Keyboard::Scan::Enter) {
+                    gameState = MENU;
+                    menu.selectedOption = 0;
+                }
+            } else if (gameState == PLAYING) {
+                // ========== MANEJO DE ENTRADA EN JUEGO ==========
+                if (game.gameOver) {
+                    // Si el juego terminó, mostrar pantalla de game over
+                    if (event.key.scancode == sf::Keyboard::Scan::Enter) {
+                        // ENTER: Reiniciar juego
+                        gameState = PLAYING;
+                        game.reset(static_cast<unsigned>(rand()));
+                        recording.start(game);
+                        particles.clear();
+                        gameOverMenu.isVisible = false;
+                    } else if (event.key.scancode == sf::Keyboard::Scan::R && gameOverMenu.isVisible) {
+                        // R: ver la repetición de la partida que terminó
+                        gameState = REPLAY;
+                        replay.start(recording, game);
+                        particles.clear();
+                        gameOverMenu.isVisible = false;
+                    }
+                } else {
+                    // Juego en progreso: manejar movimiento
+                    game.handleInput(event.key.scancode);
+                }
+            } else if (gameState == DEMO) {
+                // Cualquier otra tecla vuelve al menú
+                gameState = MENU;
+                game.reset(static_cast<unsigned>(rand()));
+                particles.clear();
+            } else if (gameState == REPLAY) {
+                // ENTER: volver al menú cuando la repetición terminó
+                if (event.key.scancode == sf::Keyboard::Scan::Enter && (replay.finished() || game.gameOver)) {
+                    gameState = MENU;
+                    game.reset(static_cast<unsigned>(rand()));
+                    particles.clear();
                 }
-                // Remover el power-up consumido
-                powerUps.erase(it);
-                break;
             }
         }
-        
-        // ========== CRECIMIENTO/ENCOGIMIENTO DE LA SERPIENTE ==========
-        // Si NO comió nada, remover el último segmento (la serpiente no crece)
-        // Si comió, mantiene el segmento extra (la serpiente crece)
-        if (!ateBlock && snake.size() > 1) {
-            snake.pop_back();  // Remover cola
-        }
-    }
+    };
     
-    // ========== DIBUJAR JUEGO ==========
-    // Renderiza todos los elementos visuales en la ventana
-    void draw(sf::RenderWindow& window) {
-        for (const auto& segment : snake) {
-            sf::RectangleShape rect(sf::Vector2f((GRID_SIZE - 2) * SCALE_X, (GRID_SIZE - 2) * SCALE_Y));
-            rect.setPosition(segment.x * GRID_SIZE * SCALE_X + SCALE_X, segment.y * GRID_SIZE * SCALE_Y + SCALE_Y);
-            rect.setFillColor(sf::Color::Green);
-            window.draw(rect);
-        }
-        
-        for (const auto& block : blocks) {
-            sf::RectangleShape rect(sf::Vector2f((block.width - 2) * SCALE_X, (block.height - 2) * SCALE_Y));
-            rect.setPosition(block.x * SCALE_X + SCALE_X, block.y * SCALE_Y + SCALE_Y);
-            rect.setFillColor(sf::Color::Red);
-            window.draw(rect);
-        }
+    while (window.isOpen()) {
+        sf::Event event;
         
-        for (const auto& powerUp : powerUps) {
-            sf::RectangleShape rect(sf::Vector2f((powerUp.width - 2) * SCALE_X, (powerUp.height - 2) * SCALE_Y));
-            rect.setPosition(powerUp.x * SCALE_X + SCALE_X, powerUp.y * SCALE_Y + SCALE_Y);
-            if (powerUp.type == WALL_PASS) {
-                rect.setFillColor(sf::Color::Yellow);
-            } else if (powerUp.type == DOUBLE_SCORE) {
-                rect.setFillColor(sf::Color::Magenta);
-            } else if (powerUp.type == MAGNET) {
-                rect.setFillColor(sf::Color(255, 165, 0));
-            } else if (powerUp.type == OBSTACLE_DESTROYER) {
-                rect.setFillColor(sf::Color::White);  // BLANCO
+        // ========== ESPERA SIN CONSUMO EN PANTALLAS ESTÁTICAS ==========
+        // Si la pantalla actual no cambia por sí sola y ya está mostrada,
+        // bloquear hasta que llegue un evento en lugar de girar a 60 fps
+        bool staticScreen = isStaticScreen();
+        if (staticScreen && !screenCache.dirty && !screenCache.pendingPresent) {
+            if (gameState == MENU && !demoShown) {
+                // El menú despierta con un evento o cuando toca la demostración
+                sf::Time untilDemo = sf::seconds(ATTRACT_DELAY_SECONDS) - menuIdle.getElapsedTime();
+                if (waitEventFor(window, event, untilDemo)) handleEvent(event);
+            } else if (window.waitEvent(event)) {
+                handleEvent(event);
             }
-            window.draw(rect);
-        }
-        
-        for (const auto& obstacle : obstacles) {
-            sf::RectangleShape rect(sf::Vector2f((obstacle.width - 2) * SCALE_X, (obstacle.height - 2) * SCALE_Y));
-            rect.setPosition(obstacle.x * SCALE_X + SCALE_X, obstacle.y * SCALE_Y + SCALE_Y);
-            rect.setFillColor(sf::Color::Cyan);
-            window.draw(rect);
-        }
-        
-        sf::RectangleShape dividerLine(sf::Vector2f(2, WINDOW_HEIGHT * SCALE_Y));
-        dividerLine.setPosition(WINDOW_WIDTH * SCALE_X, 0);
-        dividerLine.setFillColor(sf::Color::White);
-        window.draw(dividerLine);
-    }
-    
-    void drawUI(sf::RenderWindow& window) {
-        int panelStartX = WINDOW_WIDTH * SCALE_X;
-        
-        sf::RectangleShape infoBg(sf::Vector2f(PANEL_WIDTH - 10, WINDOW_HEIGHT * SCALE_Y));
-        infoBg.setPosition(panelStartX + 5, 0);
-        infoBg.setFillColor(sf::Color(0, 0, 0, 200));
-        window.draw(infoBg);
-        
-        int panelX = panelStartX + 15;
-        int yPos = 10;
-        
-        sf::RectangleShape separator(sf::Vector2f(PANEL_WIDTH - 20, 1));
-        separator.setPosition(panelX, yPos + 25);
-        separator.setFillColor(sf::Color::White);
-        window.draw(separator);
-        
-        sf::RectangleShape scoreBg(sf::Vector2f(PANEL_WIDTH - 20, 25));
-        scoreBg.setPosition(panelX, yPos);
-        scoreBg.setFillColor(sf::Color(50, 50, 50));
-        window.draw(scoreBg);
-        
-        int scoreBarWidth = (score / 10) % (PANEL_WIDTH - 20);
-        sf::RectangleShape scoreBar(sf::Vector2f(scoreBarWidth, 3));
-        scoreBar.setPosition(panelX, yPos + 22);
-        scoreBar.setFillColor(sf::Color::Green);
-        window.draw(scoreBar);
-        
-        yPos += 35;
-        
-        sf::RectangleShape applesBox(sf::Vector2f(50, 18));
-        applesBox.setPosition(panelX, yPos);
-        applesBox.setFillColor(sf::Color(100, 0, 0));
-        applesBox.setOutlineColor(sf::Color::Red);
-        applesBox.setOutlineThickness(2);
-        window.draw(applesBox);
-        
-        sf::RectangleShape appleIndicator(sf::Vector2f(8, 8));
-        appleIndicator.setPosition(panelX + 5, yPos + 5);
-        appleIndicator.setFillColor(sf::Color::Red);
-        window.draw(appleIndicator);
-        
-        int cubesPerRow = 10;
-        for (int i = 0; i < applesEaten && i < 50; i++) {
-            int xPos = panelX + 5 + (i % cubesPerRow) * 12;
-            int yPos_cube = yPos + 4 + (i / cubesPerRow) * 12;
-            sf::RectangleShape cube(sf::Vector2f(8, 8));
-            cube.setPosition(xPos, yPos_cube);
-            cube.setFillColor(sf::Color::Red);
-            cube.setOutlineColor(sf::Color::White);
-            cube.setOutlineThickness(1);
-            window.draw(cube);
-        }
-        
-        // Mostrar puntos por manzana
-        int pointsPerApple = doubleScoreActive ? 20 : 10;
-
-        sf::RectangleShape pointsBox(sf::Vector2f(PANEL_WIDTH - 20, 22));
-        pointsBox.setPosition(panelX, yPos);
-        pointsBox.setFillColor(sf::Color(0, 120, 0));
-        pointsBox.setOutlineColor(sf::Color::Green);
-        pointsBox.setOutlineThickness(1);
-        window.draw(pointsBox);
-
-        // Dibuja barras pequeñas para representar el valor
-        for (int i = 0; i < pointsPerApple / 10; i++) {
-            sf::RectangleShape pointBar(sf::Vector2f(4, 15));
-            pointBar.setPosition(panelX + 5 + i * 6, yPos + 3);
-            pointBar.setFillColor(sf::Color::Green);
-            window.draw(pointBar);
-        }
-
-        yPos += 28;
-        
-        sf::RectangleShape speedLabel(sf::Vector2f(PANEL_WIDTH - 20, 3));
-        speedLabel.setPosition(panelX, yPos);
-        speedLabel.setFillColor(sf::Color::Yellow);
-        window.draw(speedLabel);
-        
-        for (int i = 0; i < speedLevel && i < 8; i++) {
-            sf::RectangleShape speedBar(sf::Vector2f(8, 12));
-            speedBar.setPosition(panelX + i * 10, yPos + 8);
-            speedBar.setFillColor(sf::Color::Yellow);
-            window.draw(speedBar);
         }
-        
-        yPos += 30;
-        
-        if (wallPassActive) {
-            sf::RectangleShape wallPassBg(sf::Vector2f(PANEL_WIDTH - 20, 35));
-            wallPassBg.setPosition(panelX, yPos);
-            wallPassBg.setFillColor(sf::Color(100, 100, 0));
-            window.draw(wallPassBg);
+        while (window.pollEvent(event)) {
+            handleEvent(event);
+        }
+        if (!window.isOpen()) break;
+        
+        // ========== DEMOSTRACIÓN (MENÚ SIN ACTIVIDAD) ==========
+        // Una sola por cada rato sin teclas y de ATTRACT_DEMO_SECONDS: después
+        // el menú vuelve a bloquear hasta el próximo evento
+        if (gameState == MENU && !demoShown && menuIdle.getElapsedTime().asSeconds() >= ATTRACT_DELAY_SECONDS) {
+            gameState = DEMO;
+            demoShown = true;
+            demoTime.restart();
+            game.reset(static_cast<unsigned>(rand()));
+            particles.clear();
+        } else if (gameState == DEMO && demoTime.getElapsedTime().asSeconds() >= ATTRACT_DEMO_SECONDS) {
+            gameState = MENU;
+            game.reset(static_cast<unsigned>(rand()));
+            particles.clear();
+            screenCache.invalidate();
+        }
+        
+        // ========== ACTUALIZACIÓN DEL JUEGO ==========
+        bool playingFrame = gameState == PLAYING && !gameOverMenu.isVisible;
+        bool playbackFrame = gameState == DEMO || gameState == REPLAY;
+        long allocationsBefore = AllocCheck::threadAllocations();
+        if (playingFrame) {
+            // Actualizar lógica del juego (grabando la dirección de cada tick)
+            bool wasOver = game.gameOver;
+            if (!game.gameOver) recording.record(game.nextDirection);
+            game.update(TICK_SECONDS);
+            if (spectator) spectator->publish(game);
+            spawnEffects(particles, game);
+            particles.update(0.016f);
             
-            float wallPassProgress = wallPassTimer / 10.0f;
-            sf::RectangleShape wallPassBar(sf::Vector2f((PANEL_WIDTH - 20) * (1.0f - wallPassProgress), 5));
-            wallPassBar.setPosition(panelX, yPos + 28);
-            wallPassBar.setFillColor(sf::Color::Yellow);
-            window.draw(wallPassBar);
+            // La partida se registra en el tick en que termina
+            if (game.gameOver && !wasOver) {
+                sessions.submit(makeSessionRecord(game, endCauseFor(game.deathCause)));
+            }
             
-            sf::RectangleShape wallPassBorder(sf::Vector2f(PANEL_WIDTH - 20, 35));
-            wallPassBorder.setPosition(panelX, yPos);
-            wallPassBorder.setFillColor(sf::Color::Transparent);
-            wallPassBorder.setOutlineColor(sf::Color::Yellow);
-            wallPassBorder.setOutlineThickness(2);
-            window.draw(wallPassBorder);
+            // Mostrar la pantalla de game over cuando termine la explosión
+            if (game.gameOver && particles.empty()) {
+                gameOverMenu.show(game.score, game.applesEaten, sessions);
+                saveRecording();
+                screenCache.invalidate();
+            }
+        } else if (playbackFrame) {
+            // ========== AVANCE RÁPIDO ==========
+            // Varios ticks por frame (turbo.effective()); solo el estado
+            // final se dibuja y solo los eventos del último tick dan efectos
+            int ticks = turbo.run([&]() {
+                if (game.gameOver) return false;
+                if (gameState == DEMO) game.nextDirection = autopilotDirection(game);
+                else if (!replay.apply(game)) return false;
+                game.update(TICK_SECONDS);
+                return true;
+            });
+            if (ticks > 0) spawnEffects(particles, game);
+            particles.update(0.016f);
             
-            yPos += 40;
+            // La demostración empieza otra partida cuando termina la explosión
+            if (gameState == DEMO && game.gameOver && particles.empty()) {
+                game.reset(static_cast<unsigned>(rand()));
+            }
         }
         
-        if (doubleScoreActive) {
-            sf::RectangleShape doubleScoreBg(sf::Vector2f(PANEL_WIDTH - 20, 35));
-            doubleScoreBg.setPosition(panelX, yPos);
-            doubleScoreBg.setFillColor(sf::Color(100, 0, 100));
-            window.draw(doubleScoreBg);
-            
-            float doubleScoreProgress = doubleScoreTimer / 10.0f;
-            sf::RectangleShape doubleScoreBar(sf::Vector2f((PANEL_WIDTH - 20) * (1.0f - doubleScoreProgress), 5));
-            doubleScoreBar.setPosition(panelX, yPos + 28);
-            doubleScoreBar.setFillColor(sf::Color::Magenta);
-            window.draw(doubleScoreBar);
-            
-            sf::RectangleShape doubleScoreBorder(sf::Vector2f(PANEL_WIDTH - 20, 35));
-            doubleScoreBorder.setPosition(panelX, yPos);
-            doubleScoreBorder.setFillColor(sf::Color::Transparent);
-            doubleScoreBorder.setOutlineColor(sf::Color::Magenta);
-            doubleScoreBorder.setOutlineThickness(2);
-            window.draw(doubleScoreBorder);
+        // ========== RENDERIZADO SEGÚN ESTADO ==========
+        staticScreen = isStaticScreen();
+        if (!staticScreen) {
+            // Renderizar juego
+            windowRenderer.clear(sf::Color::Black);
+            drawBoard(windowRenderer);
+            particles.draw(windowRenderer);
+            game.drawUI(windowRenderer);
+            if (gameState == DEMO) banner.draw(windowRenderer, "DEMO", turbo, false);
+            if (gameState == REPLAY) banner.draw(windowRenderer, "REPLAY", turbo, replay.finished() || game.gameOver);
+            window.display();
             
-            yPos += 40;
+            // ========== VERIFICACIÓN: CERO RESERVAS EN ESTADO ESTABLE ==========
+            // Solo en la compilación instrumentada (make alloccheck)
+            if (AllocCheck::ENABLED && ++steadyFrames > AllocCheck::WARMUP_FRAMES) {
+                long allocations = AllocCheck::threadAllocations() - allocationsBefore;
+                if (allocations != 0) {
+                    std::cerr << "AllocCheck: el frame " << steadyFrames << " reservó memoria "
+                              << allocations << " veces" << std::endl;
+                    std::abort();
+                }
+            }
+            continue;
+        }
+        steadyFrames = 0;  // Cambio de pantalla: volver a calentar
+        
+        // Pantalla estática: renderizar solo si cambió, en la caché o directo
+        if (screenCache.dirty) {
+            SfmlRenderer& target = screenCache.available ? cacheRenderer : windowRenderer;
+            if (gameState == MENU) {
+                menu.draw(target.target());
+            } else if (gameState == RULES) {
+                rules.draw(target);
+            } else {
+                // Game over: el tablero congelado con el overlay encima
+                target.clear(sf::Color::Black);
+                drawBoard(target);
+                game.drawUI(target);
+                gameOverMenu.draw(target);
+            }
+            if (screenCache.available) screenCache.target.display();
+            screenCache.dirty = false;
+            screenCache.pendingPresent = true;
         }
         
-        if (magnetActive) {
-            sf::RectangleShape magnetBg(sf::Vector2f(PANEL_WIDTH - 20, 35));
-            magnetBg.setPosition(panelX, yPos);
-            magnetBg.setFillColor(sf::Color(165, 100, 0));
-            window.draw(magnetBg);
-            
-            float magnetProgress = magnetTimer / 10.0f;
-            sf::RectangleShape magnetBar(sf::Vector2f((PANEL_WIDTH - 20) * (1.0f - magnetProgress), 5));
-            magnetBar.setPosition(panelX, yPos + 28);
-            magnetBar.setFillColor(sf::Color(255, 165, 0));
-            window.draw(magnetBar);
-            
-            sf::RectangleShape magnetBorder(sf::Vector2f(PANEL_WIDTH - 20, 35));
-            magnetBorder.setPosition(panelX, yPos);
-            magnetBorder.setFillColor(sf::Color::Transparent);
-            magnetBorder.setOutlineColor(sf::Color(255, 165, 0));
-            magnetBorder.setOutlineThickness(2);
-            window.draw(magnetBorder);
+        if (screenCache.pendingPresent) {
+            if (screenCache.available) {
+                window.clear(sf::Color::Black);
+                window.draw(screenCache.sprite);
+            }
+            window.display();
+            screenCache.pendingPresent = false;
         }
     }
-};
+}
 
-class GameOverMenu {
-public:
-    bool isVisible = false;
-    int finalScore = 0;
-    int finalApplesEaten = 0;
-    int selectedOption = 0;  // 0 = Reiniciar, 1 = Salir
-    
-    // ========== TEXTURAS Y SPRITES ==========
-    sf::Texture texLoserImage;      // Textura de la imagen "loser.png"
-    sf::Sprite sprLoserImage;       // Sprite de la imagen "loser.png"
-    
-    sf::Texture texRestartButton;   // Textura del botón "REINICIAR"
-    sf::Sprite sprRestartButton;    // Sprite del botón "REINICIAR"
-    
-    sf::Texture texExitButton;      // Textura del botón "SALIR"
-    sf::Sprite sprExitButton;       // Sprite del botón "SALIR"
+// ============================================================
+// BUCLE DEL MODO ARENA
+// ============================================================
+// Sin menú: la ronda empieza al abrir la ventana. Las serpientes se
+// mueven una vez cada ARENA_FRAMES_PER_MOVE frames; ENTER empieza otra
+// ronda cuando termina y ESC cierra.
+const int ARENA_FRAMES_PER_MOVE = 4;
+
+void runArena(sf::RenderWindow& window, int bots, int players, bool gridRender) {
+    auto arena = std::make_unique<Arena>(bots, players, static_cast<unsigned>(rand()));
+    WorkerPool pool;                  // Planificación de movimientos en paralelo
+    SfmlRenderer renderer(window);
+    BoardTexture boardTexture(Arena::BOARD_COLS, Arena::BOARD_ROWS);
+    int frame = 0;
     
-    // ========== CONSTRUCTOR ==========
-    // Carga las texturas y configura los sprites
-    GameOverMenu() {
-        // Cargar textura de la imagen loser.png
-        if (!texLoserImage.loadFromFile("assets/images/loser.png")) {
-            std::cerr << "Error: No se pudo cargar la imagen loser.png" << std::endl;
+    while (window.isOpen()) {
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) window.close();
+            if (event.type != sf::Event::KeyPressed) continue;
+            if (event.key.scancode == sf::Keyboard::Scan::Escape) {
+                window.close();
+            } else if (event.key.scancode == sf::Keyboard::Scan::Enter && arena->finished) {
+                arena->reset(static_cast<unsigned>(rand()));
+            } else {
+                arena->handleInput(event.key.scancode);
+            }
         }
-        sprLoserImage.setTexture(texLoserImage);
+        if (!window.isOpen()) break;
         
-        // Cargar texturas desde archivos
-        texRestartButton.loadFromFile("assets/images/Boton.iniciar.png");
-        texExitButton.loadFromFile("assets/images/Boton.salir.png");
+        if (++frame % ARENA_FRAMES_PER_MOVE == 0) arena->tick(&pool);
         
-        // Asignar texturas a sprites
-        sprRestartButton.setTexture(texRestartButton);
-        sprExitButton.setTexture(texExitButton);
-    }
-    
-    void show(int score, int applesEaten) {
-        // Mostrar la pantalla de game over con los scores finales
-        isVisible = true;
-        finalScore = score;
-        finalApplesEaten = applesEaten;
-        selectedOption = 1;  // Seleccionar solo la opción SALIR
-    }
-    
-    // Maneja entrada del usuario en la pantalla de game over
-    void handleInput(sf::Keyboard::Scancode key) {
-        // Solo hay una opción: SALIR
-        selectedOption = 1;
-    }
-    
-    // Dibuja la pantalla de game over con la imagen loser.png
-    void draw(sf::RenderWindow& window) {
-        if (!isVisible) return;  // No dibujar si no está visible
-        
-        // Escalar y posicionar la imagen loser.png para que cubra el área de juego
-        float scaleX = (float)WINDOW_WIDTH / texLoserImage.getSize().x;
-        float scaleY = (float)WINDOW_HEIGHT / texLoserImage.getSize().y;
-        sprLoserImage.setScale(scaleX, scaleY);
-        sprLoserImage.setPosition(0, 0);
-        
-        // Dibujar la imagen loser.png
-        window.draw(sprLoserImage);
-        
-        // Fondo oscuro semitransparente en el panel lateral
-        sf::RectangleShape panelBg(sf::Vector2f(PANEL_WIDTH, SCREEN_HEIGHT));
-        panelBg.setPosition(WINDOW_WIDTH * SCALE_X, 0);
-        panelBg.setFillColor(sf::Color(0, 0, 0, 150));
-        window.draw(panelBg);
+        renderer.clear(sf::Color::Black);
+        if (gridRender) arena->drawGrid(renderer, boardTexture);
+        else arena->draw(renderer);
+        arena->drawUI(renderer);
+        window.display();
     }
-};
+}
 
-int main() {
+int main(int argc, char* argv[]) {
     try {
         srand(static_cast<unsigned>(time(0)));
         
+        // ========== ARGUMENTOS ==========
+        std::string boardPreset = "standard";
+        int arenaBots = -1;           // -1: modo normal
+        int arenaPlayers = 1;
+        bool gridRender = false;      // --render=grid: tablero como textura
+        bool spectatorFeed = false;   // --spectator: publicar el estado para otros procesos
+        std::string replayPath;       // --replay=archivo: ver una partida grabada
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg.rfind("--board=", 0) == 0) {
+                boardPreset = arg.substr(8);
+            } else if (arg == "--arena") {
+                arenaBots = 200;
+            } else if (arg.rfind("--arena=", 0) == 0) {
+                arenaBots = std::max(0, std::atoi(arg.c_str() + 8));
+            } else if (arg.rfind("--players=", 0) == 0) {
+                arenaPlayers = std::max(0, std::atoi(arg.c_str() + 10));
+            } else if (arg == "--render=grid") {
+                gridRender = true;
+            } else if (arg == "--spectator") {
+                spectatorFeed = true;
+            } else if (arg.rfind("--replay=", 0) == 0) {
+                replayPath = arg.substr(9);
+            }
+        }
+        
         calculateScaling();
         
         sf::RenderWindow window(sf::VideoMode(SCREEN_WIDTH, SCREEN_HEIGHT), "Snake vs Blocks");
@@ -956,102 +919,54 @@ int main() {
             backgroundMusic->play();
         }
     
-    // ========== INICIALIZACIÓN DE ESTADOS Y OBJETOS ==========
-    GameState_Type gameState = MENU;  // Estado inicial es el menú
-    Menu menu;                        // Instancia del menú principal
-    Rules rules;                      // Instancia de la pantalla de reglas
-    GameState game;                   // Instancia del juego
-    GameOverMenu gameOverMenu;        // Instancia del menú de game over
+        // ========== MODO ARENA ==========
+        // --arena[=bots] [--players=0|1|2]
+        if (arenaBots >= 0) {
+            runArena(window, arenaBots, arenaPlayers, gridRender);
+            return 0;
+        }
     
-    while (window.isOpen()) {
-        sf::Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed)
-                window.close();
-            
-            if (event.type == sf::Event::KeyPressed) {
-                // ========== TECLA ESC: Regresar al menú ==========
-                if (event.key.scancode == sf::Keyboard::Scan::Escape) {
-                    if (gameState == PLAYING || gameState == GAME_OVER) {
-                        gameState = MENU;
-                        game = GameState();
-                        gameOverMenu.isVisible = false;
-                    } else if (gameState == RULES) {
-                        gameState = MENU;
-                    } else {
-                        window.close();
-                    }
-                }
-                
-                // ========== MANEJO DE ENTRADA POR ESTADO ==========
-                if (gameState == MENU) {
-                    menu.handleInput(event.key.scancode);
-                    
-                    if (event.key.scancode == sf::Keyboard::Scan::Enter) {
-                        int option = menu.getSelectedOption();
-                        if (option == 0) {
-                            // Opción: INICIAR JUEGO
-                            gameState = PLAYING;
-                            game = GameState();
-                            gameOverMenu.isVisible = false;
-                        } else if (option == 1) {
-                            // Opción: REGLAS
-                            gameState = RULES;
-                        } else if (option == 2) {
-                            // Opción: SALIR
-                            window.close();
-                        }
-                    }
-                } else if (gameState == RULES) {
-                    if (event.key.scancode == sf::Keyboard::Scan::Enter) {
-                        gameState = MENU;
-                        menu.selectedOption = 0;
-                    }
-                } else if (gameState == PLAYING) {
-                    // ========== MANEJO DE ENTRADA EN JUEGO ==========
-                    if (game.gameOver) {
-                        // Si el juego terminó, mostrar pantalla de game over
-                        if (event.key.scancode == sf::Keyboard::Scan::Enter) {
-                            // ENTER: Reiniciar juego
-                            gameState = PLAYING;
-                            game = GameState();
-                            gameOverMenu.isVisible = false;
-                        }
-                    } else {
-                        // Juego en progreso: manejar movimiento
-                        game.handleInput(event.key.scancode);
-                    }
-                }
-            }
+        // Partidas y récords (el hilo escritor guarda en scores/)
+        SessionStore sessions;
+        
+        // Transmisión para overlays y herramientas (tools/spectator_reader.cpp)
+        SpectatorFeed feed;
+        SpectatorFeed* spectator = nullptr;
+        if (spectatorFeed) {
+            if (feed.open()) spectator = &feed;
+            else std::cerr << "Aviso: no se pudo crear la memoria compartida para --spectator"
+                           << " (¿otra instancia la está usando?)" << std::endl;
         }
         
-        // ========== RENDERIZADO SEGÚN ESTADO ==========
-        if (gameState == MENU) {
-            menu.draw(window);
-        } else if (gameState == RULES) {
-            rules.draw(window);
-        } else if (gameState == PLAYING) {
-            // Actualizar lógica del juego
-            game.update(0.016f);
-            
-            // Si el juego terminó, mostrar pantalla de game over
-            if (game.gameOver && !gameOverMenu.isVisible) {
-                gameOverMenu.show(game.score, game.applesEaten);
+        // ========== REPETICIÓN DESDE ARCHIVO ==========
+        // --replay=scores/last.replay: el tablero es el de la grabación
+        ReplayRecording replayFile;
+        const ReplayRecording* replay = nullptr;
+        if (!replayPath.empty()) {
+            if (!replayFile.load(replayPath)) {
+                std::cerr << "Error: no se pudo leer la repetición " << replayPath << std::endl;
+                return 1;
             }
-            
-            // Renderizar juego
-            window.clear(sf::Color::Black);
-            game.draw(window);
-            game.drawUI(window);
-            
-            // Si hay game over, dibujarlo sobre el juego
-            if (gameOverMenu.isVisible) {
-                gameOverMenu.draw(window);
+            if (replayFits<SmallGameState>(replayFile)) boardPreset = "small";
+            else if (replayFits<LargeGameState>(replayFile)) boardPreset = "large";
+            else if (replayFits<GameState>(replayFile)) boardPreset = "standard";
+            else {
+                std::cerr << "Error: la repetición es de un tablero de " << replayFile.cols << "x"
+                          << replayFile.rows << std::endl;
+                return 1;
             }
+            replay = &replayFile;
         }
         
-        window.display();
-    }
+        // ========== SELECCIÓN DEL TABLERO ==========
+        // --board=small | standard | large (por defecto: standard)
+        if (boardPreset == "small") {
+            runGame<SmallGameState>(window, sessions, gridRender, spectator, replay);
+        } else if (boardPreset == "large") {
+            runGame<LargeGameState>(window, sessions, gridRender, spectator, replay);
+        } else {
+            runGame<GameState>(window, sessions, gridRender, spectator, replay);
+        }
         
         return 0;
     } catch (const std::exception& e) {
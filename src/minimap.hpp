@@ -0,0 +1,238 @@
+// ============================================================
+// SNAKE vs BLOCKS - Minimapa del panel (pirámide de ocupación)
+// ============================================================
+// En tableros grandes (LargeGameState y la arena) el panel lateral muestra
+// el tablero completo reducido, un texel por bloque de celdas.
+//
+// - OccupancyPyramid cuenta, por bloque, cuántas celdas tienen serpiente,
+//   obstáculo, manzana o power-up, en varios niveles: bloques de 2x2
+//   celdas, de 4x4, de 8x8... hasta uno solo para todo el tablero.
+//   Cada celda que cambia ajusta un contador por nivel (change()); la
+//   pirámide nunca se recalcula entera mientras se juega.
+// - El nivel que se ve (MINIMAP_LEVEL, el primero que cabe en
+//   MINIMAP_MAX_TEXELS por lado) anota qué bloques cambiaron.
+// - Minimap::sync() recolorea solo esos bloques, y Picture sube a la GPU
+//   solo esos texels. El costo por frame depende de lo que cambió, no del
+//   tamaño del tablero.
+// ============================================================
+#pragma once
+
+#include "renderer.hpp"       // Renderer y Picture
+#include <array>              // Contadores y marcas de tamaño fijo
+#include <cstdint>            // uint16_t
+#include <memory>             // unique_ptr (la textura se mueve sin copiarse)
+
+// Tableros con más celdas que el estándar (40x30) muestran el minimapa
+constexpr int MINIMAP_MIN_CELLS = 40 * 30 + 1;
+constexpr int MINIMAP_MAX_TEXELS = 64;             // Texels por lado como máximo
+
+// Capas que cuenta la pirámide (minimapLayer() en game_state.hpp convierte
+// un CellType a su capa)
+enum MinimapLayer {
+    LAYER_NONE = -1,        // Celda vacía
+    LAYER_SNAKE,
+    LAYER_OBSTACLE,
+    LAYER_APPLE,
+    LAYER_POWERUP,
+    LAYER_COUNT
+};
+
+template <int COLS, int ROWS>
+class OccupancyPyramid {
+public:
+    struct Counts {
+        std::uint16_t layer[LAYER_COUNT];
+        int occupied() const { return layer[LAYER_SNAKE] + layer[LAYER_OBSTACLE] + layer[LAYER_APPLE] + layer[LAYER_POWERUP]; }
+    };
+
+    // ========== NIVELES ==========
+    // El nivel L agrupa bloques de 2^(L+1) x 2^(L+1) celdas
+    static constexpr int blockSize(int level) { return 2 << level; }
+    static constexpr int levelCols(int level) { return (COLS + blockSize(level) - 1) / blockSize(level); }
+    static constexpr int levelRows(int level) { return (ROWS + blockSize(level) - 1) / blockSize(level); }
+
+    static constexpr int countLevels() {
+        int level = 0;
+        while (levelCols(level) > 1 || levelRows(level) > 1) level++;
+        return level + 1;
+    }
+    static constexpr int levelOffset(int level) {
+        int offset = 0;
+        for (int l = 0; l < level; l++) offset += levelCols(l) * levelRows(l);
+        return offset;
+    }
+    static constexpr int minimapLevel() {
+        int level = 0;
+        while (levelCols(level) > MINIMAP_MAX_TEXELS || levelRows(level) > MINIMAP_MAX_TEXELS) level++;
+        return level;
+    }
+
+    static constexpr int LEVELS = countLevels();
+    static constexpr int TOTAL_BLOCKS = levelOffset(LEVELS);
+    static constexpr int MINIMAP_LEVEL = minimapLevel();
+    static constexpr int MINIMAP_COLS = levelCols(MINIMAP_LEVEL);
+    static constexpr int MINIMAP_ROWS = levelRows(MINIMAP_LEVEL);
+    static constexpr int MINIMAP_BLOCKS = MINIMAP_COLS * MINIMAP_ROWS;
+
+    OccupancyPyramid() { clear(); }
+
+private:
+    // Inicio y columnas de cada nivel en 'blocks', precalculados: change()
+    // corre por cada celda escrita y no debe repetir los bucles de arriba
+    struct LevelTable {
+        int offset[LEVELS];
+        int cols[LEVELS];
+    };
+    static constexpr LevelTable makeLevelTable() {
+        LevelTable table{};
+        for (int level = 0; level < LEVELS; level++) {
+            table.offset[level] = levelOffset(level);
+            table.cols[level] = levelCols(level);
+        }
+        return table;
+    }
+    static constexpr LevelTable LEVEL_TABLE = makeLevelTable();
+
+public:
+
+    // ========== CAMBIOS ==========
+    // Tablero vacío; todos los bloques del minimapa quedan por repintar
+    void clear() {
+        blocks.fill(Counts{});
+        dirtyCount = 0;
+        for (int i = 0; i < MINIMAP_BLOCKS; i++) {
+            dirtyFlags[i] = true;
+            dirtyBlocks[dirtyCount++] = i;
+        }
+    }
+
+    // La celda (x, y) pasó de la capa 'removed' a 'added' (MinimapLayer)
+    void change(int x, int y, int removed, int added) {
+        if (removed == added) return;
+        for (int level = 0; level < LEVELS; level++) {
+            int shift = level + 1;
+            Counts& counts = blocks[LEVEL_TABLE.offset[level] + (y >> shift) * LEVEL_TABLE.cols[level] + (x >> shift)];
+            if (removed != LAYER_NONE) counts.layer[removed]--;
+            if (added != LAYER_NONE) counts.layer[added]++;
+        }
+        int shift = MINIMAP_LEVEL + 1;
+        int local = (y >> shift) * MINIMAP_COLS + (x >> shift);
+        if (!dirtyFlags[local]) {
+            dirtyFlags[local] = true;
+            dirtyBlocks[dirtyCount++] = local;
+        }
+    }
+
+    // Carga un tablero ya armado (escenarios de prueba que escriben
+    // 'cells' directamente); el juego usa change(). layerOf(celda) da la capa.
+    template <class Cells, class LayerOf>
+    void load(const Cells& cells, LayerOf layerOf) {
+        clear();
+        for (int i = 0; i < COLS * ROWS; i++) change(i % COLS, i / COLS, LAYER_NONE, layerOf(cells[i]));
+    }
+
+    // ========== CONSULTAS ==========
+    const Counts& block(int level, int bx, int by) const {
+        return blocks[levelOffset(level) + by * levelCols(level) + bx];
+    }
+
+    // Totales del tablero (el único bloque del último nivel)
+    const Counts& total() const { return blocks[TOTAL_BLOCKS - 1]; }
+
+    // Llama a visit(bx, by, counts) por cada bloque del minimapa que
+    // cambió desde la última llamada
+    template <class Visit>
+    void takeDirty(Visit visit) {
+        for (int i = 0; i < dirtyCount; i++) {
+            int local = dirtyBlocks[i];
+            dirtyFlags[local] = false;
+            visit(local % MINIMAP_COLS, local / MINIMAP_COLS, blocks[levelOffset(MINIMAP_LEVEL) + local]);
+        }
+        dirtyCount = 0;
+    }
+
+private:
+    std::array<Counts, TOTAL_BLOCKS> blocks;                // Todos los niveles seguidos
+    std::array<bool, MINIMAP_BLOCKS> dirtyFlags{};          // Ya está en dirtyBlocks
+    std::array<int, MINIMAP_BLOCKS> dirtyBlocks{};          // Bloques del minimapa por repintar
+    int dirtyCount = 0;
+};
+
+// ============================================================
+// MINIMAPA
+// ============================================================
+// Un texel por bloque del nivel MINIMAP_LEVEL: el color de la capa con
+// más celdas en el bloque, más brillante cuanto más lleno está.
+// La imagen y la textura van por puntero: sf::Image y sf::Texture no se
+// mueven en SFML 2, y GameState::reset() movería (copiando y volviendo a
+// subir a la GPU) el minimapa en cada partida. Copiar sí duplica la imagen.
+class Minimap {
+public:
+    static constexpr float MAX_HEIGHT = 200;       // Píxeles de alto en el panel como máximo
+
+    Minimap() : picture(std::make_unique<Picture>()) {}
+    Minimap(const Minimap& other) : picture(std::make_unique<Picture>(*other.picture)) {}
+    Minimap(Minimap&&) = default;
+    Minimap& operator=(const Minimap& other) {
+        picture = std::make_unique<Picture>(*other.picture);
+        return *this;
+    }
+    Minimap& operator=(Minimap&&) = default;
+
+    // Recolorea los bloques que cambiaron (todos la primera vez)
+    template <class Pyramid>
+    void sync(Pyramid& pyramid) {
+        if (picture->getSize().x != unsigned(Pyramid::MINIMAP_COLS)) {
+            picture->create(Pyramid::MINIMAP_COLS, Pyramid::MINIMAP_ROWS, emptyColor());
+        }
+        const int area = Pyramid::blockSize(Pyramid::MINIMAP_LEVEL) * Pyramid::blockSize(Pyramid::MINIMAP_LEVEL);
+        pyramid.takeDirty([this, area](int bx, int by, const typename Pyramid::Counts& counts) {
+            picture->setPixel(bx, by, blockColor(counts.layer, area));
+        });
+    }
+
+    // Tamaño en píxeles al dibujarlo con 'width' de ancho (0 antes de sync())
+    sf::Vector2f size(float width) const {
+        sf::Vector2u texels = picture->getSize();
+        if (texels.x == 0) return sf::Vector2f(0, 0);
+        float scale = scaleFor(width);
+        return sf::Vector2f(texels.x * scale, texels.y * scale);
+    }
+
+    // En (x, y) con 'width' de ancho (menos si pasaría de MAX_HEIGHT de alto)
+    void draw(Renderer& renderer, float x, float y, float width) {
+        if (picture->getSize().x == 0) return;
+        float scale = scaleFor(width);
+        renderer.drawPicture(*picture, x, y, scale, scale);
+    }
+
+    const Picture& image() const { return *picture; }
+
+private:
+    std::unique_ptr<Picture> picture;   // Vacío solo en un Minimap ya movido
+
+    static sf::Color emptyColor() { return sf::Color(25, 25, 25); }
+
+    float scaleFor(float width) const {
+        sf::Vector2u size = picture->getSize();
+        float scale = width / size.x;
+        return size.y * scale > MAX_HEIGHT ? MAX_HEIGHT / size.y : scale;
+    }
+
+    static sf::Color blockColor(const std::uint16_t* layers, int area) {
+        // En el orden de MinimapLayer
+        static const sf::Color COLORS[LAYER_COUNT] = {sf::Color::Green, sf::Color::Cyan, sf::Color::Red,
+                                                      sf::Color::Yellow};
+        int occupied = 0, dominant = 0;
+        for (int l = 0; l < LAYER_COUNT; l++) {
+            occupied += layers[l];
+            if (layers[l] > layers[dominant]) dominant = l;
+        }
+        if (occupied == 0) return emptyColor();
+        // Un bloque con una sola celda ocupada ya se ve (40%); lleno a la mitad, al 100%
+        int fill = occupied * 2 >= area ? area : occupied * 2;
+        int brightness = 102 + 153 * fill / area;
+        const sf::Color& c = COLORS[dominant];
+        return sf::Color(c.r * brightness / 255, c.g * brightness / 255, c.b * brightness / 255);
+    }
+};
@@ -0,0 +1,121 @@
+// ============================================================
+// SNAKE vs BLOCKS - Regiones de obstáculos (conectividad del tablero)
+// ============================================================
+// Decide en tiempo casi constante si un obstáculo nuevo dejaría una zona
+// del tablero sin salida, sin recorrer el tablero con un flood fill.
+//
+// Idea: las celdas libres (conectadas por sus 4 vecinos) quedan partidas
+// solo si los obstáculos forman un anillo cerrado, conectándose por sus 8
+// vecinos (también en diagonal) o apoyándose en el borde. Se guardan los
+// grupos de obstáculos en una estructura union-find (el borde es un nodo
+// más) y se revisan solo los 8 vecinos de la celda candidata:
+//
+// - Alrededor de la celda, las celdas libres de arriba, derecha, abajo e
+//   izquierda forman "huecos" separados por tramos bloqueados.
+// - Si hay un solo hueco, el obstáculo no separa nada.
+// - Si dos tramos bloqueados distintos pertenecen al mismo grupo, el
+//   obstáculo cerraría un anillo alrededor de alguno de los huecos.
+//
+// Los obstáculos solo se agregan de a uno y se quitan todos juntos
+// (OBSTACLE_DESTROYER o reinicio), así que la estructura no necesita
+// borrar: clear() vuelve a empezar.
+// ============================================================
+#pragma once
+
+#include <array>              // Padres de tamaño fijo
+
+template <int COLS, int ROWS>
+class ObstacleRegions {
+public:
+    static constexpr int CELL_COUNT = COLS * ROWS;
+    static constexpr int BORDER = CELL_COUNT;       // Nodo que representa el borde del tablero
+
+    ObstacleRegions() { clear(); }
+
+    // Sin obstáculos
+    void clear() {
+        parent.fill(FREE);
+        parent[BORDER] = BORDER;
+    }
+
+    bool blocked(int x, int y) const {
+        return !inside(x, y) || parent[y * COLS + x] != FREE;
+    }
+
+    // Verdadero si un obstáculo en la celda libre (x, y) separaría las
+    // celdas libres en dos o más zonas
+    bool wouldSeal(int x, int y) {
+        // Vecinos en orden circular: arriba, arriba-derecha, derecha, ...
+        // (los ortogonales en las posiciones pares)
+        int start = -1;
+        for (int i = 0; i < 8; i += 2) {
+            if (!blocked(x + RING_X[i], y + RING_Y[i])) {
+                start = i;
+                break;
+            }
+        }
+        if (start < 0) return false;    // Celda encerrada: no separa a nadie más
+
+        // Un tramo bloqueado termina al llegar a un vecino ortogonal libre;
+        // se guarda el grupo de cada tramo
+        int separators[4];
+        int count = 0;
+        bool inSeparator = false;
+        for (int step = 1; step <= 8; step++) {
+            int i = (start + step) & 7;
+            int nx = x + RING_X[i], ny = y + RING_Y[i];
+            if (blocked(nx, ny)) {
+                if (!inSeparator) separators[count++] = find(node(nx, ny));
+                inSeparator = true;
+            } else if ((i & 1) == 0) {
+                inSeparator = false;
+            }
+        }
+        for (int a = 0; a < count; a++) {
+            for (int b = a + 1; b < count; b++) {
+                if (separators[a] == separators[b]) return true;
+            }
+        }
+        return false;
+    }
+
+    // Registra un obstáculo en la celda libre (x, y)
+    void add(int x, int y) {
+        int cell = y * COLS + x;
+        parent[cell] = cell;
+        for (int i = 0; i < 8; i++) {
+            int nx = x + RING_X[i], ny = y + RING_Y[i];
+            if (blocked(nx, ny)) unite(cell, node(nx, ny));
+        }
+    }
+
+private:
+    static constexpr int FREE = -1;
+    static constexpr int RING_X[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+    static constexpr int RING_Y[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+
+    std::array<int, CELL_COUNT + 1> parent;         // FREE en las celdas sin obstáculo
+
+    static bool inside(int x, int y) {
+        return static_cast<unsigned>(x) < static_cast<unsigned>(COLS) &&
+               static_cast<unsigned>(y) < static_cast<unsigned>(ROWS);
+    }
+
+    // Nodo de una celda bloqueada (el borde si está fuera del tablero)
+    static int node(int x, int y) { return inside(x, y) ? y * COLS + x : BORDER; }
+
+    // Raíz del grupo, acortando el camino a la mitad en cada paso
+    int find(int n) {
+        while (parent[n] != n) {
+            parent[n] = parent[parent[n]];
+            n = parent[n];
+        }
+        return n;
+    }
+
+    void unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a != b) parent[a] = b;
+    }
+};
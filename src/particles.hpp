@@ -0,0 +1,186 @@
+// ============================================================
+// SNAKE vs BLOCKS - Sistema de partículas
+// ============================================================
+// Efectos visuales (manzanas comidas, power-ups, OBSTACLE_DESTROYER,
+// muerte). Todas las partículas viven en un pool de capacidad fija
+// reservado una sola vez, en formato SoA (un arreglo por campo) para
+// que la integración procese 4 partículas por instrucción con SSE.
+//
+// - burst() no reserva memoria: si el pool está lleno, las partículas
+//   sobrantes simplemente no se crean.
+// - Las partículas muertas se eliminan intercambiándolas con la última
+//   viva, así las vivas siempre ocupan [0, liveCount).
+// - draw() escribe todas en un VertexArray reutilizado: una sola llamada
+//   a Renderer::drawQuads.
+// ============================================================
+#pragma once
+
+#include <SFML/Graphics.hpp>  // Vértices y colores
+#include <algorithm>          // min
+#include <cmath>              // cos, sin (tabla de direcciones)
+#include <cstddef>            // size_t
+#include <cstdint>            // uint32_t
+#include <memory>             // unique_ptr
+#include "renderer.hpp"       // Destino de dibujo
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>        // SSE2
+#define SNAKE_PARTICLES_SSE 1
+#endif
+
+class ParticleSystem {
+public:
+    static constexpr std::size_t CAPACITY = 32768;  // Máximo de partículas vivas (múltiplo de 4)
+    static constexpr float GRAVITY = 220.0f;         // Aceleración hacia abajo (px/s²)
+    static constexpr float DRAG = 1.8f;              // Frenado por segundo
+    static constexpr float SIZE = 3.0f;              // Lado del cuadrado de cada partícula (px)
+
+    // ========== CONSTRUCTOR ==========
+    // Reserva el pool y los vértices para CAPACITY partículas
+    ParticleSystem()
+        : posX(new float[CAPACITY]()), posY(new float[CAPACITY]()),
+          velX(new float[CAPACITY]()), velY(new float[CAPACITY]()),
+          life(new float[CAPACITY]()), inverseLifetime(new float[CAPACITY]()),
+          color(new std::uint32_t[CAPACITY]()),
+          vertices(sf::Triangles, CAPACITY * 6) {
+        vertices.clear();  // SFML conserva la capacidad
+        for (int i = 0; i < DIRECTIONS; i++) {
+            float angle = i * (6.2831853f / DIRECTIONS);
+            directionX[i] = std::cos(angle);
+            directionY[i] = std::sin(angle);
+        }
+    }
+
+    ParticleSystem(const ParticleSystem&) = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+    // ========== EMISIÓN ==========
+    // Partículas por ráfaga para que 'bursts' ráfagas iguales no pasen de
+    // 'budget' en total (ni de 'wanted' cada una)
+    static int perBurst(int bursts, int wanted, std::size_t budget = CAPACITY / 2) {
+        if (bursts <= 0) return wanted;
+        return std::min(wanted, static_cast<int>(budget / static_cast<std::size_t>(bursts)));
+    }
+
+    // Crea 'count' partículas en (x, y) con direcciones aleatorias y
+    // velocidad entre speed/2 y speed
+    void burst(float x, float y, int count, float speed, sf::Color tint, float lifetime) {
+        std::uint32_t packed = tint.toInteger();
+        float inverse = 1.0f / lifetime;
+        for (int i = 0; i < count && liveCount < CAPACITY; i++) {
+            int direction = static_cast<int>(random01() * DIRECTIONS);
+            float magnitude = speed * (0.5f + 0.5f * random01());
+            std::size_t p = liveCount++;
+            posX[p] = x;
+            posY[p] = y;
+            velX[p] = directionX[direction] * magnitude;
+            velY[p] = directionY[direction] * magnitude;
+            life[p] = lifetime * (0.6f + 0.4f * random01());
+            inverseLifetime[p] = inverse;
+            color[p] = packed;
+        }
+    }
+
+    // Elimina todas las partículas (al reiniciar la partida)
+    void clear() { liveCount = 0; }
+
+    bool empty() const { return liveCount == 0; }
+    std::size_t size() const { return liveCount; }
+
+    // ========== ACTUALIZACIÓN ==========
+    // Integra posición/velocidad/vida de todas las partículas vivas y
+    // retira las que se apagaron
+    void update(float deltaTime) {
+        float drag = 1.0f - DRAG * deltaTime;
+        if (drag < 0) drag = 0;
+        float gravityStep = GRAVITY * deltaTime;
+        // Se procesa hasta el siguiente múltiplo de 4: los huecos del final
+        // son memoria del pool ya reservada y no importa lo que contengan
+        std::size_t count = (liveCount + 3) & ~std::size_t(3);
+#ifdef SNAKE_PARTICLES_SSE
+        __m128 dt4 = _mm_set1_ps(deltaTime);
+        __m128 drag4 = _mm_set1_ps(drag);
+        __m128 gravity4 = _mm_set1_ps(gravityStep);
+        for (std::size_t i = 0; i < count; i += 4) {
+            __m128 vx = _mm_mul_ps(_mm_loadu_ps(velX.get() + i), drag4);
+            __m128 vy = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(velY.get() + i), drag4), gravity4);
+            _mm_storeu_ps(posX.get() + i, _mm_add_ps(_mm_loadu_ps(posX.get() + i), _mm_mul_ps(vx, dt4)));
+            _mm_storeu_ps(posY.get() + i, _mm_add_ps(_mm_loadu_ps(posY.get() + i), _mm_mul_ps(vy, dt4)));
+            _mm_storeu_ps(velX.get() + i, vx);
+            _mm_storeu_ps(velY.get() + i, vy);
+            _mm_storeu_ps(life.get() + i, _mm_sub_ps(_mm_loadu_ps(life.get() + i), dt4));
+        }
+#else
+        for (std::size_t i = 0; i < count; i++) {
+            velX[i] *= drag;
+            velY[i] = velY[i] * drag + gravityStep;
+            posX[i] += velX[i] * deltaTime;
+            posY[i] += velY[i] * deltaTime;
+            life[i] -= deltaTime;
+        }
+#endif
+        // Retirar las muertas moviendo la última viva a su lugar
+        std::size_t i = 0;
+        while (i < liveCount) {
+            if (life[i] > 0) {
+                i++;
+                continue;
+            }
+            std::size_t last = --liveCount;
+            posX[i] = posX[last];
+            posY[i] = posY[last];
+            velX[i] = velX[last];
+            velY[i] = velY[last];
+            life[i] = life[last];
+            inverseLifetime[i] = inverseLifetime[last];
+            color[i] = color[last];
+        }
+    }
+
+    // ========== DIBUJO ==========
+    // Un quad por partícula; se desvanece según la vida restante
+    void draw(Renderer& renderer) {
+        vertices.resize(liveCount * 6);  // Nunca supera la capacidad reservada
+        float half = SIZE * 0.5f;
+        for (std::size_t p = 0; p < liveCount; p++) {
+            sf::Color tint(color[p]);
+            float alpha = life[p] * inverseLifetime[p];
+            tint.a = static_cast<sf::Uint8>(tint.a * (alpha < 1.0f ? alpha : 1.0f));
+            float left = posX[p] - half, right = posX[p] + half;
+            float top = posY[p] - half, bottom = posY[p] + half;
+            sf::Vertex* quad = &vertices[p * 6];
+            quad[0] = sf::Vertex(sf::Vector2f(left, top), tint);
+            quad[1] = sf::Vertex(sf::Vector2f(right, top), tint);
+            quad[2] = sf::Vertex(sf::Vector2f(right, bottom), tint);
+            quad[3] = sf::Vertex(sf::Vector2f(left, top), tint);
+            quad[4] = sf::Vertex(sf::Vector2f(right, bottom), tint);
+            quad[5] = sf::Vertex(sf::Vector2f(left, bottom), tint);
+        }
+        if (liveCount > 0) renderer.drawQuads(&vertices[0], liveCount * 6);
+    }
+
+private:
+    // ========== POOL (SoA) ==========
+    std::unique_ptr<float[]> posX, posY;        // Posición en píxeles
+    std::unique_ptr<float[]> velX, velY;        // Velocidad (px/s)
+    std::unique_ptr<float[]> life;              // Segundos de vida restantes
+    std::unique_ptr<float[]> inverseLifetime;   // 1 / vida inicial (para el desvanecido)
+    std::unique_ptr<std::uint32_t[]> color;     // RGBA empaquetado
+    std::size_t liveCount = 0;                  // Partículas vivas: [0, liveCount)
+
+    sf::VertexArray vertices;                   // Quads del frame actual
+
+    // Direcciones precalculadas: una ráfaga grande no llama a cos/sin por partícula
+    static constexpr int DIRECTIONS = 256;
+    float directionX[DIRECTIONS];
+    float directionY[DIRECTIONS];
+    std::uint32_t rngState = 0x2545F491u;       // Solo visual: no afecta la simulación
+
+    // Número aleatorio en [0, 1) (xorshift32)
+    float random01() {
+        rngState ^= rngState << 13;
+        rngState ^= rngState >> 17;
+        rngState ^= rngState << 5;
+        return (rngState >> 8) * (1.0f / 16777216.0f);
+    }
+};
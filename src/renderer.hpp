@@ -0,0 +1,150 @@
+// ============================================================
+// SNAKE vs BLOCKS - Interfaz de renderizado
+// ============================================================
+// El juego dibuja a través de Renderer en lugar de usar directamente
+// un sf::RenderTarget. Hay dos implementaciones:
+//
+// - SfmlRenderer: la ventana o un RenderTexture (necesita contexto GL).
+// - SoftwareRenderer (software_renderer.hpp): un buffer RGBA en
+//   memoria, para pruebas con imágenes de referencia y miniaturas en
+//   máquinas sin GPU.
+//
+// Todo lo que dibuja el juego son quads alineados a los ejes: celdas,
+// rectángulos del panel, letras del atlas e imágenes escaladas.
+// ============================================================
+#pragma once
+
+#include <SFML/Graphics.hpp>  // Vértices, colores, imágenes y texturas
+#include <cstddef>            // size_t
+#include <string>
+#include <vector>             // Texels modificados
+
+// ============================================================
+// CLASE: Picture
+// ============================================================
+// Imagen que puede dibujar cualquier backend: los píxeles viven en
+// memoria (sf::Image, no necesita GPU) y la textura solo se crea la
+// primera vez que la pide el backend SFML.
+//
+// setPixel() anota el texel modificado: la próxima vez que se pide la
+// textura solo se suben esos texels (o la imagen entera si son muchos).
+class Picture {
+public:
+    static constexpr std::size_t MAX_DIRTY = 256;   // Texels sueltos antes de subir todo
+
+    bool loadFromFile(const std::string& path) {
+        uploaded = false;
+        return pixels.loadFromFile(path);
+    }
+
+    void create(const sf::Image& image) {
+        pixels = image;
+        uploaded = false;
+    }
+
+    void create(unsigned width, unsigned height, sf::Color color) {
+        pixels.create(width, height, color);
+        dirty.reserve(MAX_DIRTY);
+        uploaded = false;
+    }
+
+    void setPixel(unsigned x, unsigned y, sf::Color color) {
+        pixels.setPixel(x, y, color);
+        if (!uploaded || dirtyAll) return;
+        if (dirty.size() < MAX_DIRTY) dirty.push_back(y * pixels.getSize().x + x);
+        else dirtyAll = true;
+    }
+
+    const sf::Image& image() const { return pixels; }
+    sf::Vector2u getSize() const { return pixels.getSize(); }
+
+    // Textura para el backend SFML (se sube a la GPU una sola vez y
+    // después solo lo que cambió)
+    const sf::Texture& texture() const {
+        if (!uploaded) {
+            gpu.loadFromImage(pixels);
+            uploaded = true;
+        } else if (dirtyAll) {
+            gpu.update(pixels);
+        } else {
+            unsigned width = pixels.getSize().x;
+            for (unsigned texel : dirty) {
+                gpu.update(pixels.getPixelsPtr() + texel * 4, 1, 1, texel % width, texel / width);
+            }
+        }
+        dirty.clear();
+        dirtyAll = false;
+        return gpu;
+    }
+
+private:
+    sf::Image pixels;
+    mutable sf::Texture gpu;
+    mutable bool uploaded = false;
+    mutable std::vector<unsigned> dirty;   // Texels (y * ancho + x) sin subir
+    mutable bool dirtyAll = false;         // Demasiados cambios: subir la imagen entera
+};
+
+// ============================================================
+// CLASE: Renderer
+// ============================================================
+class Renderer {
+public:
+    virtual ~Renderer() = default;
+
+    // Llena todo el destino con un color
+    virtual void clear(sf::Color color) = 0;
+
+    // Quads alineados a los ejes guardados como pares de triángulos: 6
+    // vértices por quad, el vértice 0 es la esquina superior izquierda y
+    // el 2 la inferior derecha (el formato de appendCell y HudBatch).
+    // Con 'texture' cada quad muestrea la textura con sus texCoords y la
+    // multiplica por el color del vértice.
+    virtual void drawQuads(const sf::Vertex* vertices, std::size_t count, const Picture* texture = nullptr) = 0;
+
+    // Rectángulo relleno
+    virtual void fillRect(float x, float y, float w, float h, sf::Color color) = 0;
+
+    // Imagen completa en (x, y) escalada por (scaleX, scaleY)
+    virtual void drawPicture(const Picture& picture, float x, float y, float scaleX, float scaleY) = 0;
+};
+
+// ============================================================
+// CLASE: SfmlRenderer
+// ============================================================
+// Dibuja en un sf::RenderTarget. Las formas se reutilizan entre
+// llamadas para no reservar memoria en cada frame.
+class SfmlRenderer : public Renderer {
+public:
+    explicit SfmlRenderer(sf::RenderTarget& target) : output(target) {}
+
+    sf::RenderTarget& target() { return output; }
+
+    void clear(sf::Color color) override { output.clear(color); }
+
+    void drawQuads(const sf::Vertex* vertices, std::size_t count, const Picture* texture = nullptr) override {
+        if (count == 0) return;
+        sf::RenderStates states;
+        if (texture) states.texture = &texture->texture();
+        output.draw(vertices, count, sf::Triangles, states);
+    }
+
+    void fillRect(float x, float y, float w, float h, sf::Color color) override {
+        rect.setSize(sf::Vector2f(w, h));
+        rect.setPosition(x, y);
+        rect.setFillColor(color);
+        output.draw(rect);
+    }
+
+    void drawPicture(const Picture& picture, float x, float y, float scaleX, float scaleY) override {
+        sprite.setTexture(picture.texture(), true);
+        sprite.setPosition(x, y);
+        sprite.setScale(scaleX, scaleY);
+        output.draw(sprite);
+    }
+
+private:
+    sf::RenderTarget& output;
+    sf::RectangleShape rect;    // Rectángulo reutilizable
+    sf::Sprite sprite;          // Sprite reutilizable
+};
@@ -0,0 +1,167 @@
+// ============================================================
+// SNAKE vs BLOCKS - Repeticiones de partidas
+// ============================================================
+// La simulación es determinista: con la misma semilla y la misma
+// dirección pedida antes de cada tick, la partida se repite igual. Una
+// repetición guarda solo eso: la semilla, el tablero, los ticks jugados y
+// los ticks en los que cambió la dirección pedida.
+//
+// - ReplayRecording graba mientras se juega (sin reservar memoria: la
+//   lista de cambios se reserva una vez) y se guarda/carga de un archivo.
+// - ReplayPlayer la reproduce sobre un BasicGameState, tick por tick; el
+//   bucle principal la corre con avance rápido (fast_forward.hpp).
+//
+// Formato del archivo (little endian):
+//   [0] magic "SVBP"   [4] versión   [8] semilla   [12] columnas
+//   [16] filas   [20] ticks   [24] cambios   [28] CRC-32 del resto
+//   y por cada cambio: [0] tick   [4] dirección
+// ============================================================
+#pragma once
+
+#include "session_store.hpp"  // put32/get32 y CRC-32 del formato binario
+#include <cstdint>
+#include <cstdio>             // FILE*, fopen
+#include <string>
+#include <vector>
+
+class ReplayRecording {
+public:
+    static constexpr int MAX_CHANGES = 1 << 16;     // Cambios de dirección por partida
+    static constexpr std::uint32_t MAGIC = 0x50425653u;     // "SVBP"
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::size_t HEADER_SIZE = 32;
+    static constexpr std::size_t CHANGE_SIZE = 8;
+
+    struct Change {
+        std::uint32_t tick;       // Tick (desde 0) antes del cual se pide la dirección
+        std::uint32_t direction;  // 0=arriba, 1=derecha, 2=abajo, 3=izquierda
+    };
+
+    std::uint32_t seed = 0;
+    int cols = 0, rows = 0;
+    std::uint32_t ticks = 0;      // Ticks que se pueden reproducir
+    std::vector<Change> changes;
+
+    ReplayRecording() { changes.reserve(MAX_CHANGES); }
+
+    // ========== GRABACIÓN ==========
+    // Empieza a grabar una partida recién reiniciada
+    template <class Game>
+    void start(const Game& game) {
+        seed = game.seed;
+        cols = Game::BOARD_COLS;
+        rows = Game::BOARD_ROWS;
+        ticks = 0;
+        changes.clear();
+        full = false;
+    }
+
+    // Antes de cada tick, con la dirección que va a usar. Si se llena la
+    // lista, la repetición termina en ese tick.
+    void record(int direction) {
+        if (full) return;
+        if (changes.empty() || changes.back().direction != static_cast<std::uint32_t>(direction)) {
+            if (changes.size() == static_cast<std::size_t>(MAX_CHANGES)) {
+                full = true;
+                return;
+            }
+            changes.push_back(Change{ticks, static_cast<std::uint32_t>(direction)});
+        }
+        ticks++;
+    }
+
+    // ========== ARCHIVO ==========
+    bool save(const std::string& path) const {
+        std::vector<unsigned char> data(HEADER_SIZE + changes.size() * CHANGE_SIZE);
+        using namespace SessionFormat;
+        put32(&data[0], MAGIC);
+        put32(&data[4], VERSION);
+        put32(&data[8], seed);
+        put32(&data[12], static_cast<std::uint32_t>(cols));
+        put32(&data[16], static_cast<std::uint32_t>(rows));
+        put32(&data[20], ticks);
+        put32(&data[24], static_cast<std::uint32_t>(changes.size()));
+        for (std::size_t i = 0; i < changes.size(); i++) {
+            put32(&data[HEADER_SIZE + i * CHANGE_SIZE], changes[i].tick);
+            put32(&data[HEADER_SIZE + i * CHANGE_SIZE + 4], changes[i].direction);
+        }
+        put32(&data[28], checksum(data));
+
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) return false;
+        bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+        return std::fclose(file) == 0 && ok;
+    }
+
+    // false si el archivo no existe, está incompleto o dañado
+    bool load(const std::string& path) {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file) return false;
+        std::vector<unsigned char> data;
+        unsigned char buffer[4096];
+        std::size_t count;
+        while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) data.insert(data.end(), buffer, buffer + count);
+        std::fclose(file);
+
+        using namespace SessionFormat;
+        if (data.size() < HEADER_SIZE || get32(&data[0]) != MAGIC || get32(&data[4]) != VERSION) return false;
+        std::uint32_t changeCount = get32(&data[24]);
+        if (changeCount > static_cast<std::uint32_t>(MAX_CHANGES)) return false;
+        if (data.size() != HEADER_SIZE + changeCount * CHANGE_SIZE || get32(&data[28]) != checksum(data)) return false;
+
+        seed = get32(&data[8]);
+        cols = static_cast<int>(get32(&data[12]));
+        rows = static_cast<int>(get32(&data[16]));
+        ticks = get32(&data[20]);
+        changes.clear();
+        for (std::uint32_t i = 0; i < changeCount; i++) {
+            changes.push_back(Change{get32(&data[HEADER_SIZE + i * CHANGE_SIZE]),
+                                     get32(&data[HEADER_SIZE + i * CHANGE_SIZE + 4]) & 3});
+        }
+        full = false;
+        return true;
+    }
+
+private:
+    bool full = false;            // Se llenó 'changes': no se graba más
+
+    // CRC-32 de todo menos el campo del CRC
+    static std::uint32_t checksum(const std::vector<unsigned char>& data) {
+        std::uint32_t crc = SessionCrc::crc32(data.data(), 28);
+        return SessionCrc::crc32(data.data() + HEADER_SIZE, data.size() - HEADER_SIZE, crc);
+    }
+};
+
+// ============================================================
+// REPRODUCCIÓN
+// ============================================================
+class ReplayPlayer {
+public:
+    // Reinicia 'game' con la semilla de la grabación (del mismo tablero)
+    template <class Game>
+    void start(const ReplayRecording& replay, Game& game) {
+        recording = &replay;
+        next = 0;
+        tick = 0;
+        game.reset(replay.seed);
+    }
+
+    // Antes de cada tick: pide la dirección grabada. false si la
+    // repetición ya terminó (no hay que correr el tick)
+    template <class Game>
+    bool apply(Game& game) {
+        if (finished()) return false;
+        const std::vector<ReplayRecording::Change>& changes = recording->changes;
+        while (next < changes.size() && changes[next].tick <= tick) game.nextDirection = changes[next++].direction;
+        tick++;
+        return true;
+    }
+
+    bool finished() const { return !recording || tick >= recording->ticks; }
+    std::uint32_t ticksPlayed() const { return tick; }
+
+private:
+    const ReplayRecording* recording = nullptr;
+    std::size_t next = 0;         // Próximo cambio de dirección
+    std::uint32_t tick = 0;
+};
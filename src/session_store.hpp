@@ -0,0 +1,420 @@
+// ============================================================
+// SNAKE vs BLOCKS - Registro de partidas y tabla de récords
+// ============================================================
+// Guarda cada partida terminada en un log binario de solo-anexado
+// con checksum por registro, y mantiene en memoria las K mejores
+// puntuaciones. Al arrancar, el top-K se reconstruye desde un índice
+// binario compacto más los registros que se agregaron después de él.
+//
+// - Las escrituras las hace un hilo de fondo: submit() solo encola.
+// - Si el proceso muere a mitad de una escritura, el registro
+//   incompleto del final se detecta por su tamaño/CRC y se descarta.
+// - El índice se reescribe en un archivo temporal y se renombra,
+//   así nunca queda un índice a medias.
+// ============================================================
+#pragma once
+
+#include <algorithm>          // sort, min
+#include <array>              // Tabla del CRC
+#include <chrono>             // Intervalo de escritura del índice
+#include <condition_variable> // Despertar al hilo escritor
+#include <cstdint>            // Tipos de tamaño fijo
+#include <cstdio>             // FILE*, fopen, fwrite
+#include <cstring>            // memcpy, memcmp
+#include <filesystem>         // Crear carpeta, truncar el log
+#include <mutex>              // Cola y top-K compartidos
+#include <string>
+#include <system_error>       // error_code de filesystem
+#include <thread>             // Hilo escritor
+#include <vector>
+
+// ============================================================
+// CRC-32 (polinomio IEEE 802.3)
+// ============================================================
+namespace SessionCrc {
+
+constexpr std::array<std::uint32_t, 256> makeTable() {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; i++) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        table[i] = c;
+    }
+    return table;
+}
+
+inline constexpr std::array<std::uint32_t, 256> TABLE = makeTable();
+
+inline std::uint32_t crc32(const void* data, std::size_t size, std::uint32_t crc = 0) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; i++) crc = TABLE[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+}  // namespace SessionCrc
+
+// ============================================================
+// REGISTRO DE UNA PARTIDA
+// ============================================================
+
+// Causa de fin de partida guardada en el log
+enum SessionEndCause : unsigned char {
+    END_UNKNOWN = 0,     // Desconocida
+    END_WALL,            // Chocó con la pared
+    END_SELF,            // Chocó consigo misma
+    END_OBSTACLE,        // Chocó con un obstáculo
+    END_QUIT             // El jugador salió con ESC
+};
+
+struct SessionRecord {
+    std::int32_t score = 0;             // Puntuación final
+    std::int32_t applesEaten = 0;       // Manzanas comidas
+    std::uint32_t durationMs = 0;       // Duración de la partida
+    std::uint32_t seed = 0;             // Semilla de la partida
+    std::uint32_t timestamp = 0;        // Fin de la partida (segundos Unix)
+    unsigned char cause = END_UNKNOWN;  // SessionEndCause
+
+    // Orden del top-K: más puntos, luego más manzanas, luego la más antigua
+    bool ranksAbove(const SessionRecord& other) const {
+        if (score != other.score) return score > other.score;
+        if (applesEaten != other.applesEaten) return applesEaten > other.applesEaten;
+        return timestamp < other.timestamp;
+    }
+};
+
+// ============================================================
+// FORMATO EN DISCO
+// ============================================================
+// Log: registros de 32 bytes, little-endian
+//   [0]  magic 'SVBR'   [4]  score       [8]  apples     [12] durationMs
+//   [16] seed           [20] timestamp   [24] cause + 3 bytes en cero
+//   [28] CRC-32 de los bytes [0, 28)
+// Índice: cabecera de 40 bytes + K registros de 32 bytes
+//   [0] "SVBIDX01"  [8] logBytes cubiertos  [16] registros en el log
+//   [24] K  [28] entradas  [32] reservado  [36] CRC-32 de todo lo demás
+namespace SessionFormat {
+
+constexpr std::size_t RECORD_SIZE = 32;
+constexpr std::size_t INDEX_HEADER_SIZE = 40;
+constexpr std::uint32_t RECORD_MAGIC = 0x52425653u;  // "SVBR"
+constexpr char INDEX_MAGIC[8] = {'S', 'V', 'B', 'I', 'D', 'X', '0', '1'};
+
+inline void put32(unsigned char* p, std::uint32_t v) {
+    p[0] = v & 0xFF; p[1] = (v >> 8) & 0xFF; p[2] = (v >> 16) & 0xFF; p[3] = (v >> 24) & 0xFF;
+}
+inline std::uint32_t get32(const unsigned char* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (std::uint32_t(p[3]) << 24);
+}
+inline void put64(unsigned char* p, std::uint64_t v) {
+    put32(p, static_cast<std::uint32_t>(v));
+    put32(p + 4, static_cast<std::uint32_t>(v >> 32));
+}
+inline std::uint64_t get64(const unsigned char* p) {
+    return get32(p) | (std::uint64_t(get32(p + 4)) << 32);
+}
+
+// fseek con desplazamiento de 64 bits: 'long' es de 32 bits en Windows
+// (también con mingw) y el log puede pasar de 2 GB
+inline bool seekTo(FILE* file, std::uint64_t offset) {
+#ifdef _WIN32
+    return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+inline void encode(const SessionRecord& r, unsigned char* out) {
+    put32(out, RECORD_MAGIC);
+    put32(out + 4, static_cast<std::uint32_t>(r.score));
+    put32(out + 8, static_cast<std::uint32_t>(r.applesEaten));
+    put32(out + 12, r.durationMs);
+    put32(out + 16, r.seed);
+    put32(out + 20, r.timestamp);
+    put32(out + 24, r.cause);
+    put32(out + 28, SessionCrc::crc32(out, 28));
+}
+
+// Devuelve false si el registro está incompleto o corrupto
+inline bool decode(const unsigned char* in, SessionRecord& r) {
+    if (get32(in) != RECORD_MAGIC || get32(in + 28) != SessionCrc::crc32(in, 28)) return false;
+    r.score = static_cast<std::int32_t>(get32(in + 4));
+    r.applesEaten = static_cast<std::int32_t>(get32(in + 8));
+    r.durationMs = get32(in + 12);
+    r.seed = get32(in + 16);
+    r.timestamp = get32(in + 20);
+    r.cause = static_cast<unsigned char>(get32(in + 24));
+    return true;
+}
+
+}  // namespace SessionFormat
+
+// ============================================================
+// CLASE: SessionStore
+// ============================================================
+class SessionStore {
+public:
+    // ========== CONSTRUCTOR ==========
+    // Carga el top-K (índice + cola del log) y arranca el hilo escritor
+    explicit SessionStore(const std::string& directory = "scores", int topCount = 10)
+        : logPath(directory + "/sessions.log"),
+          indexPath(directory + "/sessions.idx"),
+          topCount(topCount) {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        pending.reserve(64);
+        loadTopScores();
+        writer = std::thread([this] { writerLoop(); });
+    }
+
+    // Termina de escribir lo pendiente y guarda el índice
+    ~SessionStore() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stopping = true;
+        }
+        queueReady.notify_one();
+        if (writer.joinable()) writer.join();
+    }
+
+    SessionStore(const SessionStore&) = delete;
+    SessionStore& operator=(const SessionStore&) = delete;
+
+    // ========== ESCRITURA ==========
+    // Encola una partida para el hilo escritor (no toca el disco)
+    void submit(const SessionRecord& record) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            pending.push_back(record);
+        }
+        queueReady.notify_one();
+    }
+
+    // ========== CONSULTA ==========
+    // Copia del top-K actual, de mejor a peor (incluye lo encolado ya procesado)
+    std::vector<SessionRecord> topScores() const {
+        std::lock_guard<std::mutex> lock(topMutex);
+        return top;
+    }
+
+    // Mejor puntuación registrada (0 si no hay ninguna)
+    int bestScore() const {
+        std::lock_guard<std::mutex> lock(topMutex);
+        return top.empty() ? 0 : top.front().score;
+    }
+
+    // Total de partidas en el log
+    std::uint64_t sessionCount() const {
+        std::lock_guard<std::mutex> lock(topMutex);
+        return recordCount;
+    }
+
+private:
+    // ========== CONFIGURACIÓN ==========
+    static constexpr std::size_t INDEX_EVERY_RECORDS = 4096;  // Reescribir el índice cada N registros
+    static constexpr int INDEX_EVERY_SECONDS = 2;             // ... o cada N segundos con cambios
+
+    std::string logPath;                // Log de partidas (solo anexado)
+    std::string indexPath;              // Índice del top-K
+    int topCount;                       // K
+
+    // ========== ESTADO COMPARTIDO ==========
+    mutable std::mutex topMutex;        // Protege top, recordCount
+    std::vector<SessionRecord> top;     // Mejores K, ordenadas
+    std::uint64_t recordCount = 0;      // Registros válidos en el log
+    std::uint64_t logBytes = 0;         // Bytes válidos del log (múltiplo de RECORD_SIZE)
+
+    std::mutex queueMutex;              // Protege pending, stopping
+    std::condition_variable queueReady;
+    std::vector<SessionRecord> pending; // Partidas encoladas
+    bool stopping = false;
+
+    std::thread writer;                 // Hilo escritor
+
+    // ========== TOP-K ==========
+    // Inserta en el top-K si corresponde (K es pequeño: inserción lineal)
+    void offer(const SessionRecord& record) {
+        if ((int)top.size() == topCount && !record.ranksAbove(top.back())) return;
+        auto position = std::find_if(top.begin(), top.end(),
+                                     [&](const SessionRecord& r) { return record.ranksAbove(r); });
+        top.insert(position, record);
+        if ((int)top.size() > topCount) top.pop_back();
+    }
+
+    // ========== CARGA AL ARRANCAR ==========
+    void loadTopScores() {
+        std::uint64_t scanFrom = 0;
+        if (readIndex(scanFrom)) {
+            scanLog(scanFrom);
+        } else {
+            top.clear();
+            recordCount = 0;
+            scanLog(0);
+        }
+    }
+
+    // Lee el índice; devuelve false si falta, está corrupto o no coincide con el log
+    bool readIndex(std::uint64_t& coveredBytes) {
+        using namespace SessionFormat;
+        FILE* file = std::fopen(indexPath.c_str(), "rb");
+        if (!file) return false;
+        std::vector<unsigned char> data;
+        unsigned char chunk[4096];
+        std::size_t n;
+        while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) data.insert(data.end(), chunk, chunk + n);
+        std::fclose(file);
+
+        if (data.size() < INDEX_HEADER_SIZE || std::memcmp(data.data(), INDEX_MAGIC, 8) != 0) return false;
+        std::uint32_t entries = get32(&data[28]);
+        if (data.size() != INDEX_HEADER_SIZE + entries * RECORD_SIZE) return false;
+        std::uint32_t storedCrc = get32(&data[36]);
+        put32(&data[36], 0);
+        if (SessionCrc::crc32(data.data(), data.size()) != storedCrc) return false;
+
+        coveredBytes = get64(&data[8]);
+        std::error_code error;
+        std::uint64_t currentLogSize = std::filesystem::file_size(logPath, error);
+        if (error || currentLogSize < coveredBytes) return false;  // El log cambió: reconstruir
+
+        top.clear();
+        for (std::uint32_t i = 0; i < entries; i++) {
+            SessionRecord record;
+            if (!decode(&data[INDEX_HEADER_SIZE + i * RECORD_SIZE], record)) return false;
+            offer(record);
+        }
+        recordCount = get64(&data[16]);
+        logBytes = coveredBytes;
+        return true;
+    }
+
+    // Recorre el log desde 'offset' agregando cada registro válido al top-K.
+    // Un registro incompleto al final (proceso terminado a mitad de una
+    // escritura) se elimina truncando el log para que los siguientes queden alineados.
+    void scanLog(std::uint64_t offset) {
+        using namespace SessionFormat;
+        logBytes = offset;
+        FILE* file = std::fopen(logPath.c_str(), "rb");
+        if (!file) return;
+        if (offset > 0 && !seekTo(file, offset)) {
+            std::fclose(file);
+            return;
+        }
+
+        std::vector<unsigned char> buffer(RECORD_SIZE * 4096);
+        std::size_t carry = 0;  // Bytes de un registro partido entre lecturas
+        std::size_t n;
+        while ((n = std::fread(buffer.data() + carry, 1, buffer.size() - carry, file)) > 0) {
+            std::size_t available = carry + n;
+            std::size_t whole = available - available % RECORD_SIZE;
+            for (std::size_t p = 0; p < whole; p += RECORD_SIZE) {
+                SessionRecord record;
+                if (decode(&buffer[p], record)) {   // Registro dañado en medio: se salta
+                    offer(record);
+                    recordCount++;
+                }
+            }
+            logBytes += whole;
+            carry = available - whole;
+            std::memmove(buffer.data(), buffer.data() + whole, carry);
+        }
+        std::fclose(file);
+
+        if (carry > 0) {
+            std::error_code error;
+            std::filesystem::resize_file(logPath, logBytes, error);
+        }
+    }
+
+    // ========== ÍNDICE ==========
+    // Escribe el índice en un temporal y lo renombra sobre el anterior
+    void writeIndex() {
+        using namespace SessionFormat;
+        std::vector<unsigned char> data;
+        {
+            std::lock_guard<std::mutex> lock(topMutex);
+            data.assign(INDEX_HEADER_SIZE + top.size() * RECORD_SIZE, 0);
+            std::memcpy(data.data(), INDEX_MAGIC, 8);
+            put64(&data[8], logBytes);
+            put64(&data[16], recordCount);
+            put32(&data[24], static_cast<std::uint32_t>(topCount));
+            put32(&data[28], static_cast<std::uint32_t>(top.size()));
+            for (std::size_t i = 0; i < top.size(); i++) encode(top[i], &data[INDEX_HEADER_SIZE + i * RECORD_SIZE]);
+        }
+        put32(&data[36], SessionCrc::crc32(data.data(), data.size()));
+
+        std::string tempPath = indexPath + ".tmp";
+        FILE* file = std::fopen(tempPath.c_str(), "wb");
+        if (!file) return;
+        bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+        ok = (std::fflush(file) == 0) && ok;
+        std::fclose(file);
+        if (!ok) return;
+
+        // En Windows rename no reemplaza: si el proceso muere entre remove y rename
+        // solo se pierde el índice, y el próximo arranque lo reconstruye desde el log
+        std::error_code error;
+        std::filesystem::rename(tempPath, indexPath, error);
+        if (error) {
+            std::filesystem::remove(indexPath, error);
+            std::filesystem::rename(tempPath, indexPath, error);
+        }
+    }
+
+    // ========== HILO ESCRITOR ==========
+    void writerLoop() {
+        using namespace SessionFormat;
+        FILE* log = std::fopen(logPath.c_str(), "ab");
+        std::vector<SessionRecord> batch;
+        batch.reserve(64);
+        std::vector<unsigned char> bytes;
+        std::size_t unindexed = 0;
+        auto lastIndexWrite = std::chrono::steady_clock::now();
+
+        while (true) {
+            bool stop;
+            {
+                std::unique_lock<std::mutex> lock(queueMutex);
+                queueReady.wait_for(lock, std::chrono::seconds(INDEX_EVERY_SECONDS),
+                                    [this] { return !pending.empty() || stopping; });
+                batch.swap(pending);
+                stop = stopping;
+            }
+
+            if (!batch.empty()) {
+                // Todo el lote en una sola escritura al final del log
+                bytes.resize(batch.size() * RECORD_SIZE);
+                for (std::size_t i = 0; i < batch.size(); i++) encode(batch[i], &bytes[i * RECORD_SIZE]);
+                bool written = log && std::fwrite(bytes.data(), 1, bytes.size(), log) == bytes.size();
+                written = log && std::fflush(log) == 0 && written;
+
+                if (written) {
+                    std::lock_guard<std::mutex> lock(topMutex);
+                    for (const SessionRecord& record : batch) offer(record);
+                    recordCount += batch.size();
+                    logBytes += bytes.size();
+                    unindexed += batch.size();
+                } else if (log) {
+                    // Lo que llegó a escribirse del lote queda a medias: se
+                    // corta el log en el último registro completo y se reabre
+                    // para que los siguientes lotes sigan alineados
+                    std::fclose(log);
+                    std::error_code error;
+                    std::filesystem::resize_file(logPath, logBytes, error);
+                    log = std::fopen(logPath.c_str(), "ab");
+                }
+                batch.clear();
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            bool indexDue = unindexed >= INDEX_EVERY_RECORDS ||
+                            (unindexed > 0 && now - lastIndexWrite >= std::chrono::seconds(INDEX_EVERY_SECONDS));
+            if (indexDue || (stop && unindexed > 0)) {
+                writeIndex();
+                unindexed = 0;
+                lastIndexWrite = now;
+            }
+            if (stop) break;
+        }
+        if (log) std::fclose(log);
+    }
+};
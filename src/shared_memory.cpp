@@ -0,0 +1,136 @@
+// ============================================================
+// SNAKE vs BLOCKS - Memoria compartida (implementación por sistema)
+// ============================================================
+#include "shared_memory.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+namespace {
+std::string mappingName(const std::string& name) { return "Local\\" + name; }
+}  // namespace
+
+bool SharedMemory::create(const std::string& name, std::size_t size) {
+    close();
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                        static_cast<DWORD>((unsigned long long)size >> 32),
+                                        static_cast<DWORD>(size & 0xFFFFFFFFu), mappingName(name).c_str());
+    if (!mapping) return false;
+    if (GetLastError() == ERROR_ALREADY_EXISTS) {
+        CloseHandle(mapping);   // La está usando otro proceso
+        return false;
+    }
+    memory = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!memory) {
+        CloseHandle(mapping);
+        return false;
+    }
+    handle = mapping;
+    bytes = size;
+    return true;
+}
+
+bool SharedMemory::open(const std::string& name, std::size_t size) {
+    close();
+    HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, mappingName(name).c_str());
+    if (!mapping) return false;
+    memory = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+    if (!memory) {
+        CloseHandle(mapping);
+        return false;
+    }
+    handle = mapping;
+    bytes = size;
+    return true;
+}
+
+void SharedMemory::remove(const std::string&) {}
+
+std::uint32_t SharedMemory::currentProcess() { return GetCurrentProcessId(); }
+
+bool SharedMemory::processAlive(std::uint32_t process) {
+    HANDLE handle = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, process);
+    if (!handle) return GetLastError() == ERROR_ACCESS_DENIED;  // Existe pero es de otro usuario
+    DWORD exitCode = 0;
+    bool alive = GetExitCodeProcess(handle, &exitCode) && exitCode == STILL_ACTIVE;
+    CloseHandle(handle);
+    return alive;
+}
+
+void SharedMemory::close() {
+    if (memory) UnmapViewOfFile(memory);
+    if (handle) CloseHandle(static_cast<HANDLE>(handle));
+    memory = nullptr;
+    handle = nullptr;
+    bytes = 0;
+}
+
+#else
+#include <cerrno>             // EPERM
+#include <csignal>            // kill (¿sigue vivo el proceso?)
+#include <fcntl.h>            // O_CREAT, O_EXCL, O_RDWR
+#include <sys/mman.h>         // shm_open, mmap
+#include <sys/stat.h>         // fstat
+#include <unistd.h>           // ftruncate, close
+
+namespace {
+std::string objectName(const std::string& name) { return "/" + name; }
+}  // namespace
+
+bool SharedMemory::create(const std::string& name, std::size_t size) {
+    close();
+    // O_EXCL: nunca mapear una región ajena (otra instancia, otro usuario
+    // o una que quedó de un proceso que murió sin cerrarla)
+    int fd = shm_open(objectName(name).c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) return false;
+    void* mapped = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(size)) == 0) {
+        mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        shm_unlink(objectName(name).c_str());   // No dejar el nombre tomado por una región a medias
+        return false;
+    }
+    memory = mapped;
+    bytes = size;
+    ownedName = objectName(name);
+    return true;
+}
+
+bool SharedMemory::open(const std::string& name, std::size_t size) {
+    close();
+    int fd = shm_open(objectName(name).c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < size) {
+        ::close(fd);  // Región de otra versión (más chica): leerla daría SIGBUS
+        return false;
+    }
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) return false;
+    memory = mapped;
+    bytes = size;
+    return true;
+}
+
+void SharedMemory::remove(const std::string& name) { shm_unlink(objectName(name).c_str()); }
+
+std::uint32_t SharedMemory::currentProcess() { return static_cast<std::uint32_t>(getpid()); }
+
+bool SharedMemory::processAlive(std::uint32_t process) {
+    if (process == 0) return false;
+    return kill(static_cast<pid_t>(process), 0) == 0 || errno == EPERM;  // EPERM: existe, de otro usuario
+}
+
+void SharedMemory::close() {
+    if (memory) munmap(memory, bytes);
+    if (!ownedName.empty()) shm_unlink(ownedName.c_str());
+    memory = nullptr;
+    bytes = 0;
+    ownedName.clear();
+}
+#endif
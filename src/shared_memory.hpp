@@ -0,0 +1,50 @@
+// ============================================================
+// SNAKE vs BLOCKS - Memoria compartida entre procesos
+// ============================================================
+// Región con nombre que pueden mapear otros procesos de la misma
+// máquina (CreateFileMapping en Windows, shm_open + mmap en el resto).
+// El código del sistema operativo está en shared_memory.cpp para que
+// <windows.h> no llegue a los demás archivos.
+// ============================================================
+#pragma once
+
+#include <cstddef>            // size_t
+#include <cstdint>            // uint32_t (id de proceso)
+#include <string>
+
+class SharedMemory {
+public:
+    SharedMemory() = default;
+    ~SharedMemory() { close(); }
+
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    // Crea la región 'name' de 'size' bytes, inicializada a cero. Falla si
+    // ya existe (la usa otra instancia o quedó de un proceso que murió:
+    // quien la usa decide si la reclama con remove()). Quien la crea la
+    // elimina al cerrarla.
+    bool create(const std::string& name, std::size_t size);
+
+    // Abre una región que ya creó otro proceso
+    bool open(const std::string& name, std::size_t size);
+
+    void close();
+
+    // Elimina el nombre de una región que dejó un proceso que murió (en
+    // Windows no hace nada: la región desaparece con su último proceso)
+    static void remove(const std::string& name);
+
+    // Id del proceso actual y si un proceso con ese id sigue vivo
+    static std::uint32_t currentProcess();
+    static bool processAlive(std::uint32_t process);
+
+    void* data() const { return memory; }
+    std::size_t size() const { return bytes; }
+
+private:
+    void* memory = nullptr;
+    std::size_t bytes = 0;
+    void* handle = nullptr;       // HANDLE del mapeo (solo Windows)
+    std::string ownedName;        // Nombre a eliminar al cerrar (solo POSIX, quien la creó)
+};
@@ -0,0 +1,249 @@
+// ============================================================
+// SNAKE vs BLOCKS - Rasterizador por software
+// ============================================================
+// Implementación de Renderer sobre un buffer RGBA en memoria. No
+// necesita ventana ni contexto GL: sirve para comparar frames con
+// imágenes de referencia (make test) y para generar miniaturas en las
+// herramientas por lotes.
+//
+// - Solo dibuja quads alineados a los ejes (lo único que usa el juego).
+// - Un píxel se cubre si su centro está dentro del quad, igual que la
+//   regla de rasterización de OpenGL para estos casos.
+// - Mezcla alfa como sf::BlendAlpha, en enteros: SSE2 procesa 4 píxeles
+//   a la vez y la versión escalar da exactamente el mismo resultado.
+// - 'scale' multiplica todas las coordenadas: con 1/8 se obtiene una
+//   miniatura sin renderizar el frame completo.
+// ============================================================
+#pragma once
+
+#include "renderer.hpp"       // Interfaz Renderer y Picture
+#include <algorithm>          // min, max
+#include <cmath>              // ceil, floor
+#include <cstdint>            // uint32_t
+#include <cstdio>             // FILE*, fopen (PPM)
+#include <string>
+#include <vector>             // Buffer de píxeles
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>        // SSE2
+#define SNAKE_RASTER_SSE 1
+#endif
+
+class SoftwareRenderer : public Renderer {
+public:
+    // ========== CONSTRUCTOR ==========
+    // Buffer de width x height píxeles; 'scale' convierte las coordenadas
+    // del juego (píxeles de pantalla) a píxeles del buffer
+    SoftwareRenderer(unsigned width, unsigned height, float scale = 1.0f)
+        : bufferWidth(width), bufferHeight(height), scale(scale),
+          buffer(static_cast<std::size_t>(width) * height, pack(sf::Color::Black)) {
+        runs.reserve(width);
+    }
+
+    unsigned width() const { return bufferWidth; }
+    unsigned height() const { return bufferHeight; }
+
+    // Píxeles en orden R, G, B, A (como sf::Image)
+    const std::uint32_t* pixels() const { return buffer.data(); }
+
+    sf::Color pixel(unsigned x, unsigned y) const { return unpack(buffer[static_cast<std::size_t>(y) * bufferWidth + x]); }
+
+    // ========== RENDERER ==========
+    void clear(sf::Color color) override {
+        std::fill(buffer.begin(), buffer.end(), pack(color));
+    }
+
+    void drawQuads(const sf::Vertex* vertices, std::size_t count, const Picture* texture = nullptr) override {
+        for (std::size_t v = 0; v + 5 < count; v += 6) {
+            const sf::Vertex& topLeft = vertices[v];
+            const sf::Vertex& bottomRight = vertices[v + 2];
+            float x0 = topLeft.position.x, y0 = topLeft.position.y;
+            float x1 = bottomRight.position.x, y1 = bottomRight.position.y;
+            if (x1 <= x0 || y1 <= y0) continue;  // Quad vacío (slot oculto del HUD)
+
+            if (!texture) {
+                fillPixels(x0, y0, x1, y1, topLeft.color);
+                continue;
+            }
+            sf::Vector2f uv0 = topLeft.texCoords, uv1 = bottomRight.texCoords;
+            if (uv1.x - uv0.x <= 1.0f && uv1.y - uv0.y <= 1.0f) {
+                // Un solo texel (bloque sólido del atlas): es un relleno
+                fillPixels(x0, y0, x1, y1, modulate(texel(texture->image(), uv0.x, uv0.y), topLeft.color));
+            } else {
+                drawTextured(x0, y0, x1, y1, uv0, uv1, texture->image(), topLeft.color);
+            }
+        }
+    }
+
+    void fillRect(float x, float y, float w, float h, sf::Color color) override {
+        if (w > 0 && h > 0) fillPixels(x, y, x + w, y + h, color);
+    }
+
+    void drawPicture(const Picture& picture, float x, float y, float scaleX, float scaleY) override {
+        sf::Vector2u size = picture.getSize();
+        if (size.x == 0 || size.y == 0) return;
+        drawTextured(x, y, x + size.x * scaleX, y + size.y * scaleY,
+                     sf::Vector2f(0, 0), sf::Vector2f(float(size.x), float(size.y)), picture.image(), sf::Color::White);
+    }
+
+    // ========== SALIDA ==========
+    // Guarda el buffer como PPM binario (P6, sin alfa)
+    bool savePpm(const std::string& path) const {
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) return false;
+        std::fprintf(file, "P6\n%u %u\n255\n", bufferWidth, bufferHeight);
+        std::vector<unsigned char> row(bufferWidth * 3);
+        bool ok = true;
+        for (unsigned y = 0; y < bufferHeight && ok; y++) {
+            for (unsigned x = 0; x < bufferWidth; x++) {
+                sf::Color c = pixel(x, y);
+                row[x * 3] = c.r;
+                row[x * 3 + 1] = c.g;
+                row[x * 3 + 2] = c.b;
+            }
+            ok = std::fwrite(row.data(), 1, row.size(), file) == row.size();
+        }
+        return std::fclose(file) == 0 && ok;
+    }
+
+private:
+    unsigned bufferWidth, bufferHeight;
+    float scale;
+    std::vector<std::uint32_t> buffer;  // RGBA por píxel (R en el byte bajo)
+
+    // Píxeles consecutivos de una fila que muestrean la misma columna
+    struct Run {
+        int begin, end;
+        int column;
+    };
+    std::vector<Run> runs;              // Reservado para un quad del ancho del buffer
+
+    static std::uint32_t pack(sf::Color c) {
+        return std::uint32_t(c.r) | (std::uint32_t(c.g) << 8) | (std::uint32_t(c.b) << 16) | (std::uint32_t(c.a) << 24);
+    }
+
+    static sf::Color unpack(std::uint32_t p) {
+        return sf::Color(p & 0xFF, (p >> 8) & 0xFF, (p >> 16) & 0xFF, p >> 24);
+    }
+
+    // x / 255 redondeado, exacto para x en [0, 255 * 255 + 255]
+    static std::uint32_t div255(std::uint32_t x) {
+        x += 128;
+        return (x + (x >> 8)) >> 8;
+    }
+
+    // Color de textura multiplicado por el color del vértice
+    static sf::Color modulate(sf::Color a, sf::Color b) {
+        return sf::Color(div255(a.r * b.r), div255(a.g * b.g), div255(a.b * b.b), div255(a.a * b.a));
+    }
+
+    // Texel más cercano (coordenadas en píxeles de la textura)
+    static sf::Color texel(const sf::Image& image, float u, float v) {
+        sf::Vector2u size = image.getSize();
+        int x = std::min(std::max(int(std::floor(u)), 0), int(size.x) - 1);
+        int y = std::min(std::max(int(std::floor(v)), 0), int(size.y) - 1);
+        return image.getPixel(x, y);
+    }
+
+    // Mezcla alfa de un píxel (sf::BlendAlpha): color = src*a + dst*(1-a),
+    // alfa = a + dstA*(1-a)
+    static std::uint32_t blend(std::uint32_t dst, sf::Color src) {
+        std::uint32_t a = src.a, inv = 255 - a;
+        sf::Color d = unpack(dst);
+        return pack(sf::Color(div255(src.r * a + d.r * inv), div255(src.g * a + d.g * inv),
+                              div255(src.b * a + d.b * inv), div255(255 * a + d.a * inv)));
+    }
+
+    // Rango de píxeles [first, last) cuyos centros están en [from, to)
+    void pixelRange(float from, float to, unsigned limit, int& first, int& last) const {
+        first = std::max(int(std::ceil(from * scale - 0.5f)), 0);
+        last = std::min(int(std::ceil(to * scale - 0.5f)), int(limit));
+    }
+
+    // Rellena un rectángulo (coordenadas del juego) con un color
+    void fillPixels(float x0, float y0, float x1, float y1, sf::Color color) {
+        if (color.a == 0) return;
+        int px0, px1, py0, py1;
+        pixelRange(x0, x1, bufferWidth, px0, px1);
+        pixelRange(y0, y1, bufferHeight, py0, py1);
+        for (int y = py0; y < py1; y++) {
+            std::uint32_t* row = &buffer[static_cast<std::size_t>(y) * bufferWidth];
+            if (color.a == 255) fillSpan(row, px0, px1, pack(color));
+            else blendSpan(row, px0, px1, color);
+        }
+    }
+
+    // Escribe un color opaco en [x0, x1) de una fila
+    static void fillSpan(std::uint32_t* row, int x0, int x1, std::uint32_t packed) {
+        int x = x0;
+#ifdef SNAKE_RASTER_SSE
+        __m128i color4 = _mm_set1_epi32(static_cast<int>(packed));
+        for (; x + 4 <= x1; x += 4) _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x), color4);
+#endif
+        for (; x < x1; x++) row[x] = packed;
+    }
+
+    // Mezcla un color semitransparente sobre [x0, x1) de una fila
+    static void blendSpan(std::uint32_t* row, int x0, int x1, sf::Color color) {
+        int x = x0;
+#ifdef SNAKE_RASTER_SSE
+        // Por canal en 16 bits: (src * a + dst * (255 - a) + 128) / 255,
+        // con el canal alfa de la fuente en 255 (así da a + dstA * (1 - a))
+        std::uint32_t a = color.a;
+        __m128i zero = _mm_setzero_si128();
+        __m128i source = _mm_set_epi16(short(255 * a), short(color.b * a), short(color.g * a), short(color.r * a),
+                                       short(255 * a), short(color.b * a), short(color.g * a), short(color.r * a));
+        __m128i inverse = _mm_set1_epi16(short(255 - a));
+        __m128i half = _mm_set1_epi16(128);
+        for (; x + 4 <= x1; x += 4) {
+            __m128i dst = _mm_loadu_si128(reinterpret_cast<__m128i*>(row + x));
+            __m128i lo = _mm_unpacklo_epi8(dst, zero);
+            __m128i hi = _mm_unpackhi_epi8(dst, zero);
+            lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, inverse), source), half);
+            hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, inverse), source), half);
+            lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x), _mm_packus_epi16(lo, hi));
+        }
+#endif
+        for (; x < x1; x++) row[x] = blend(row[x], color);
+    }
+
+    // Quad texturizado con muestreo del texel más cercano. La columna de
+    // texel solo depende de x: se calcula una vez por quad como tramos
+    // de píxeles con el mismo texel y cada fila rellena esos tramos.
+    void drawTextured(float x0, float y0, float x1, float y1, sf::Vector2f uv0, sf::Vector2f uv1,
+                      const sf::Image& image, sf::Color tint) {
+        int px0, px1, py0, py1;
+        pixelRange(x0, x1, bufferWidth, px0, px1);
+        pixelRange(y0, y1, bufferHeight, py0, py1);
+        if (px0 >= px1 || py0 >= py1) return;
+        sf::Vector2u size = image.getSize();
+        float du = (uv1.x - uv0.x) / (x1 - x0);
+        float dv = (uv1.y - uv0.y) / (y1 - y0);
+        bool plainTint = tint == sf::Color::White;
+
+        runs.clear();
+        for (int x = px0; x < px1; x++) {
+            float u = uv0.x + ((x + 0.5f) / scale - x0) * du;
+            int column = std::min(std::max(int(std::floor(u)), 0), int(size.x) - 1);
+            if (!runs.empty() && runs.back().column == column) runs.back().end = x + 1;
+            else runs.push_back(Run{x, x + 1, column});
+        }
+
+        const sf::Uint8* texels = image.getPixelsPtr();
+        for (int y = py0; y < py1; y++) {
+            float v = uv0.y + ((y + 0.5f) / scale - y0) * dv;
+            int line = std::min(std::max(int(std::floor(v)), 0), int(size.y) - 1);
+            const sf::Uint8* source = texels + static_cast<std::size_t>(line) * size.x * 4;
+            std::uint32_t* row = &buffer[static_cast<std::size_t>(y) * bufferWidth];
+            for (const Run& run : runs) {
+                const sf::Uint8* t = source + run.column * 4;
+                sf::Color color(t[0], t[1], t[2], t[3]);
+                if (!plainTint) color = modulate(color, tint);
+                if (color.a == 255) fillSpan(row, run.begin, run.end, pack(color));
+                else if (color.a != 0) blendSpan(row, run.begin, run.end, color);
+            }
+        }
+    }
+};
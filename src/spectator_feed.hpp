@@ -0,0 +1,129 @@
+// ============================================================
+// SNAKE vs BLOCKS - Transmisión del estado para espectadores
+// ============================================================
+// Publica cada tick una instantánea del juego (serpiente, entidades,
+// puntuación, power-ups activos) en memoria compartida para que otros
+// procesos locales (overlays de streaming, paneles) la lean sin capturar
+// la pantalla. El formato y el protocolo están en spectator_layout.hpp;
+// aquí solo el escritor, que convierte el estado del juego.
+// ============================================================
+#pragma once
+
+#include "game_state.hpp"     // BasicGameState, CellType, POWERUP_COUNT
+#include "shared_memory.hpp"  // Región con nombre entre procesos
+#include "spectator_layout.hpp" // Formato de la región y lector
+#include <atomic>             // Secuencias del seqlock
+#include <cstdint>
+#include <new>                // placement new de la región
+
+// El formato no incluye game_state.hpp: sus copias de las constantes del
+// juego tienen que coincidir
+static_assert(FEED_POWERUP_COUNT == POWERUP_COUNT, "FEED_POWERUP_COUNT desactualizado");
+static_assert(FEED_CELL_APPLE == CELL_APPLE && FEED_CELL_OBSTACLE == CELL_OBSTACLE && FEED_CELL_POWERUP == CELL_POWERUP,
+              "FEED_CELL_* desactualizados");
+
+// ============================================================
+// ESCRITOR (el juego)
+// ============================================================
+class SpectatorWriter {
+public:
+    SpectatorWriter() = default;
+
+    // Usa 'memory' (al menos sizeof(FeedRegion) bytes, en cero) como
+    // región de la transmisión del proceso 'owner'
+    SpectatorWriter(void* memory, std::uint32_t owner) : region(new (memory) FeedRegion) {
+        region->header.magic = 0;   // Los lectores no la usan hasta que esté lista
+        std::atomic_thread_fence(std::memory_order_release);
+        for (FeedSlot& slot : region->slots) slot.sequence.store(0, std::memory_order_relaxed);
+        region->header.published.store(0, std::memory_order_relaxed);
+        region->header.layoutVersion = FEED_LAYOUT_VERSION;
+        region->header.slotCount = FEED_SLOTS;
+        region->header.snapshotSize = sizeof(SpectatorSnapshot);
+        region->header.ownerProcess = owner;
+        std::atomic_thread_fence(std::memory_order_release);
+        region->header.magic = FEED_MAGIC;
+    }
+
+    // Escribe el estado actual en el siguiente slot (sin reservar memoria
+    // y copiando solo los segmentos y entidades que existen)
+    template <class Game>
+    void publish(const Game& game) {
+        static_assert(Game::CELL_COUNT <= SpectatorSnapshot::MAX_CELLS, "El tablero no cabe en la instantánea");
+        std::uint64_t frame = region->header.published.load(std::memory_order_relaxed);
+        FeedSlot& slot = region->slots[frame % FEED_SLOTS];
+        std::uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        SpectatorSnapshot& s = slot.snapshot;
+        s.frame = frame;
+        s.gameSeed = game.seed;
+        s.cols = Game::BOARD_COLS;
+        s.rows = Game::BOARD_ROWS;
+        s.score = game.score;
+        s.applesEaten = game.applesEaten;
+        s.speedLevel = game.speedLevel;
+        s.gameSeconds = game.gameTimer;
+        s.direction = static_cast<std::uint8_t>(game.direction);
+        s.gameOver = game.gameOver;
+        s.deathCause = static_cast<std::uint8_t>(game.deathCause);
+        for (int type = 0; type < POWERUP_COUNT; type++) {
+            s.powerUpSeconds[type] = game.powerUpSecondsLeft(static_cast<PowerUpType>(type));
+        }
+        std::uint32_t length = 0;
+        for (const SnakeSegment& segment : game.snake) {
+            s.snake[length++] = FeedPoint{std::uint16_t(segment.x), std::uint16_t(segment.y)};
+        }
+        s.snakeLength = length;
+        std::uint32_t items = 0;
+        for (const Block& b : game.blocks) s.items[items++] = item(b.x, b.y, CELL_APPLE);
+        for (const PowerUp& p : game.powerUps) s.items[items++] = item(p.x, p.y, powerUpCell(p.type));
+        for (const Obstacle& o : game.obstacles) s.items[items++] = item(o.x, o.y, CELL_OBSTACLE);
+        s.itemCount = items;
+
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+        region->header.published.store(frame + 1, std::memory_order_release);
+    }
+
+private:
+    FeedRegion* region = nullptr;
+
+    static FeedItem item(int x, int y, unsigned char cell) {
+        return FeedItem{std::uint16_t(x), std::uint16_t(y), cell, {0, 0, 0}};
+    }
+};
+
+// ============================================================
+// TRANSMISIÓN DEL JUEGO
+// ============================================================
+// Crea la región FEED_NAME y publica en ella (--spectator). Si ya existe
+// y su dueño murió sin cerrarla (cierre forzado), la elimina y la vuelve
+// a crear; si el dueño sigue vivo (otra instancia), open() falla.
+class SpectatorFeed {
+public:
+    bool open(const char* name = FEED_NAME) {
+        if (!memory.create(name, sizeof(FeedRegion))) {
+            if (!abandoned(name)) return false;
+            SharedMemory::remove(name);
+            if (!memory.create(name, sizeof(FeedRegion))) return false;
+        }
+        writer = SpectatorWriter(memory.data(), SharedMemory::currentProcess());
+        return true;
+    }
+
+    template <class Game>
+    void publish(const Game& game) { writer.publish(game); }
+
+private:
+    SharedMemory memory;
+    SpectatorWriter writer;
+
+    // La región existente es de esta versión y su proceso ya no existe
+    // (una de otra versión o a medio crear no se toca)
+    static bool abandoned(const char* name) {
+        SharedMemory existing;
+        if (!existing.open(name, sizeof(FeedRegion))) return false;
+        SpectatorReader reader(existing.data());
+        return reader.compatible() && !SharedMemory::processAlive(reader.owner());
+    }
+};
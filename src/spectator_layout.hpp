@@ -0,0 +1,161 @@
+// ============================================================
+// SNAKE vs BLOCKS - Formato de la transmisión para espectadores
+// ============================================================
+// Lo que comparten el juego (spectator_feed.hpp) y los lectores: la
+// región en memoria compartida y SpectatorReader. No depende del juego
+// ni de SFML, así un lector solo necesita este archivo y
+// shared_memory.hpp. Lector de referencia: tools/spectator_reader.cpp.
+//
+// Formato de la región (FEED_LAYOUT_VERSION):
+//   FeedHeader                 magic, versión, cantidad de slots, proceso
+//                              dueño y número de instantáneas publicadas
+//   FeedSlot[FEED_SLOTS]       secuencia + SpectatorSnapshot
+//
+// Protocolo (un escritor, cualquier cantidad de lectores):
+// - El juego escribe la instantánea N en el slot N % FEED_SLOTS
+//   directamente en la región (sin buffer intermedio) con un seqlock:
+//   la secuencia del slot es impar mientras se escribe y par al terminar.
+//   Después publica N + 1 en el encabezado.
+// - El lector toma el último slot publicado, lee sin bloquear y valida
+//   que la secuencia no cambió; si cambió (el juego dio la vuelta a los
+//   slots mientras leía) lo descarta y reintenta.
+// - El juego nunca espera a los lectores.
+// ============================================================
+#pragma once
+
+#include <algorithm>          // min
+#include <atomic>             // Secuencias del seqlock
+#include <cstddef>            // offsetof
+#include <cstdint>
+#include <cstring>            // memcpy
+#include <type_traits>        // is_trivially_copyable
+
+const char* const FEED_NAME = "snake_vs_blocks_spectator";
+const std::uint32_t FEED_MAGIC = 0x534E4B46;        // "SNKF"
+const std::uint32_t FEED_LAYOUT_VERSION = 2;        // Cambia con cualquier cambio de formato
+const int FEED_SLOTS = 4;
+const int FEED_POWERUP_COUNT = 4;                   // POWERUP_COUNT del juego
+
+// Valores de FeedItem::cell (los mismos que CellType del juego)
+const std::uint8_t FEED_CELL_APPLE = 2;
+const std::uint8_t FEED_CELL_OBSTACLE = 3;
+const std::uint8_t FEED_CELL_POWERUP = 4;           // + tipo (0=WALL_PASS ... 3=OBSTACLE_DESTROYER)
+
+// ========== INSTANTÁNEA ==========
+// Solo tipos de tamaño fijo: la leen procesos compilados por separado
+struct FeedPoint {
+    std::uint16_t x, y;
+};
+
+struct FeedItem {
+    std::uint16_t x, y;
+    std::uint8_t cell;            // FEED_CELL_APPLE, FEED_CELL_OBSTACLE o FEED_CELL_POWERUP + tipo
+    std::uint8_t reserved[3];
+};
+
+struct SpectatorSnapshot {
+    static constexpr int MAX_CELLS = 64 * 48;       // El tablero más grande (LargeGameState)
+
+    std::uint64_t frame;          // Número de instantánea desde que empezó el juego
+    std::uint32_t gameSeed;       // Semilla de la partida (cambia al reiniciar)
+    std::uint16_t cols, rows;     // Tamaño del tablero
+    std::int32_t score;
+    std::int32_t applesEaten;
+    std::int32_t speedLevel;
+    float gameSeconds;            // Tiempo de juego de la partida
+    std::uint8_t direction;       // 0=arriba, 1=derecha, 2=abajo, 3=izquierda
+    std::uint8_t gameOver;
+    std::uint8_t deathCause;      // DeathCause del juego
+    std::uint8_t reserved;
+    float powerUpSeconds[FEED_POWERUP_COUNT];       // Segundos restantes (0 si no está activo)
+    std::uint32_t snakeLength;    // Segmentos válidos en 'snake' (cabeza primero)
+    std::uint32_t itemCount;      // Entidades válidas en 'items'
+    FeedPoint snake[MAX_CELLS];
+    FeedItem items[MAX_CELLS];    // Manzanas, power-ups y obstáculos
+};
+
+struct FeedHeader {
+    std::uint32_t magic;
+    std::uint32_t layoutVersion;
+    std::uint32_t slotCount;
+    std::uint32_t snapshotSize;
+    std::uint32_t ownerProcess;   // Id del proceso del juego (para reclamar la región si murió)
+    std::uint32_t reserved;
+    std::atomic<std::uint64_t> published;           // Instantáneas publicadas (la última es published - 1)
+};
+
+struct FeedSlot {
+    std::atomic<std::uint32_t> sequence;            // Impar: escribiendo
+    SpectatorSnapshot snapshot;
+};
+
+struct FeedRegion {
+    FeedHeader header;
+    FeedSlot slots[FEED_SLOTS];
+};
+
+static_assert(std::is_trivially_copyable<SpectatorSnapshot>::value, "La instantánea se copia con memcpy");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Los contadores deben funcionar entre procesos");
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "Los contadores deben funcionar entre procesos");
+
+// ============================================================
+// LECTOR (otros procesos)
+// ============================================================
+class SpectatorReader {
+public:
+    explicit SpectatorReader(const void* memory) : region(static_cast<const FeedRegion*>(memory)) {}
+
+    // La región tiene el formato que entiende este lector
+    bool compatible() const {
+        if (region->header.magic != FEED_MAGIC) return false;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return region->header.layoutVersion == FEED_LAYOUT_VERSION && region->header.slotCount == FEED_SLOTS &&
+               region->header.snapshotSize == sizeof(SpectatorSnapshot);
+    }
+
+    // Proceso del juego que publica (solo válido si compatible())
+    std::uint32_t owner() const { return region->header.ownerProcess; }
+
+    // Instantáneas publicadas hasta ahora (0: el juego todavía no publicó)
+    std::uint64_t published() const { return region->header.published.load(std::memory_order_acquire); }
+
+    // Lee la última instantánea en su lugar, sin copiarla: llama a
+    // visit(const SpectatorSnapshot&) y devuelve true si los datos que vio
+    // eran consistentes. Si devuelve false lo que visit() extrajo puede
+    // estar mezclado y hay que descartarlo (el juego ya escribió otra).
+    // visit() debe tolerar datos a medio escribir: nada de confiar en
+    // snakeLength o itemCount sin acotarlos a MAX_CELLS.
+    template <class Visit>
+    bool view(Visit visit) const {
+        std::uint64_t count = published();
+        if (count == 0) return false;
+        const FeedSlot& slot = region->slots[(count - 1) % FEED_SLOTS];
+        std::uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before & 1) return false;
+        visit(slot.snapshot);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.sequence.load(std::memory_order_relaxed) == before;
+    }
+
+    // Copia la última instantánea completa (reintenta si se cruzó con
+    // una escritura); false si no hay ninguna o no se logró en 'attempts'
+    bool copy(SpectatorSnapshot& out, int attempts = 8) const {
+        for (int i = 0; i < attempts; i++) {
+            bool ok = view([&out](const SpectatorSnapshot& s) {
+                // Solo la cabecera y los elementos válidos
+                std::memcpy(&out, &s, offsetof(SpectatorSnapshot, snake));
+                std::uint32_t length = std::min<std::uint32_t>(s.snakeLength, SpectatorSnapshot::MAX_CELLS);
+                std::uint32_t items = std::min<std::uint32_t>(s.itemCount, SpectatorSnapshot::MAX_CELLS);
+                std::memcpy(out.snake, s.snake, length * sizeof(FeedPoint));
+                std::memcpy(out.items, s.items, items * sizeof(FeedItem));
+                out.snakeLength = length;
+                out.itemCount = items;
+            });
+            if (ok) return true;
+        }
+        return false;
+    }
+
+private:
+    const FeedRegion* region;
+};
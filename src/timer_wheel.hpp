@@ -0,0 +1,127 @@
+// ============================================================
+// SNAKE vs BLOCKS - Rueda de temporizadores jerárquica
+// ============================================================
+// Programa eventos a N ticks en el futuro (spawns, fin de power-ups).
+// Avanzar un tick solo toca los temporizadores que vencen en ese tick,
+// en lugar de sumar y comparar cada temporizador en cada frame.
+//
+// - 4 niveles de 64 casillas: el nivel k cubre distancias de hasta
+//   64^(k+1) ticks (unos 3 días a 60 ticks/s en total).
+// - Cuando el nivel 0 da la vuelta, la casilla que toca del nivel 1 se
+//   redistribuye hacia abajo (y así con los niveles superiores).
+// - Capacidad fija (un nodo por id) y listas enlazadas por índices:
+//   copiar, programar o cancelar nunca reserva memoria.
+// ============================================================
+#pragma once
+
+#include <array>              // Nodos y casillas
+#include <cstdint>            // uint32_t
+
+template <int CAPACITY>
+class TimerWheel {
+public:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;                              // Casillas por nivel
+    static constexpr std::uint32_t MAX_DELAY = (1u << (SLOT_BITS * LEVELS)) - 1;
+
+    TimerWheel() {
+        for (auto& level : heads) level.fill(NONE);
+    }
+
+    // ========== PROGRAMAR / CANCELAR ==========
+    // Vence dentro de 'delay' ticks (mínimo 1). Si 'id' ya estaba
+    // programado, se reemplaza.
+    void schedule(int id, std::uint32_t delay) {
+        if (nodes[id].active) unlink(id);
+        if (delay < 1) delay = 1;
+        if (delay > MAX_DELAY) delay = MAX_DELAY;
+        nodes[id].deadline = current + delay;
+        link(id);
+    }
+
+    void cancel(int id) {
+        if (nodes[id].active) unlink(id);
+    }
+
+    bool active(int id) const { return nodes[id].active; }
+
+    // Ticks que faltan para que venza 'id' (0 si no está programado)
+    std::uint32_t remaining(int id) const {
+        return nodes[id].active ? nodes[id].deadline - current : 0;
+    }
+
+    std::uint32_t now() const { return current; }
+
+    // ========== AVANCE ==========
+    // Avanza un tick y llama a onExpire(id) por cada temporizador que
+    // vence. onExpire puede volver a programar temporizadores.
+    template <class OnExpire>
+    void advance(OnExpire&& onExpire) {
+        current++;
+        // Bajar un nivel los temporizadores de la casilla que acaba de llegar
+        for (int level = 1; level < LEVELS; level++) {
+            if (slotIndex(current, level - 1) != 0) break;
+            cascade(level, slotIndex(current, level));
+        }
+        int& head = heads[0][slotIndex(current, 0)];
+        while (head != NONE) {
+            int id = head;
+            unlink(id);
+            onExpire(id);
+        }
+    }
+
+private:
+    static constexpr int NONE = -1;
+
+    struct Node {
+        std::uint32_t deadline = 0;     // Tick en el que vence
+        int prev = NONE, next = NONE;   // Lista de la casilla
+        int level = 0, slot = 0;        // Casilla donde está enlazado
+        bool active = false;
+    };
+
+    std::array<Node, CAPACITY> nodes{};
+    std::array<std::array<int, SLOTS>, LEVELS> heads{};   // Primer nodo de cada casilla
+    std::uint32_t current = 0;                            // Tick actual
+
+    static int slotIndex(std::uint32_t tick, int level) {
+        return static_cast<int>((tick >> (SLOT_BITS * level)) & (SLOTS - 1));
+    }
+
+    // Enlaza en la casilla según la distancia a su vencimiento
+    void link(int id) {
+        Node& node = nodes[id];
+        std::uint32_t distance = node.deadline - current;
+        int level = 0;
+        while (level < LEVELS - 1 && distance >= (1u << (SLOT_BITS * (level + 1)))) level++;
+        node.level = level;
+        node.slot = slotIndex(node.deadline, level);
+        node.prev = NONE;
+        node.next = heads[level][node.slot];
+        if (node.next != NONE) nodes[node.next].prev = id;
+        heads[level][node.slot] = id;
+        node.active = true;
+    }
+
+    void unlink(int id) {
+        Node& node = nodes[id];
+        if (node.prev != NONE) nodes[node.prev].next = node.next;
+        else heads[node.level][node.slot] = node.next;
+        if (node.next != NONE) nodes[node.next].prev = node.prev;
+        node.prev = node.next = NONE;
+        node.active = false;
+    }
+
+    // Reubica todos los nodos de una casilla según su distancia actual
+    void cascade(int level, int slot) {
+        int id = heads[level][slot];
+        heads[level][slot] = NONE;
+        while (id != NONE) {
+            int next = nodes[id].next;
+            link(id);
+            id = next;
+        }
+    }
+};
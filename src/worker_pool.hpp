@@ -0,0 +1,122 @@
+// ============================================================
+// SNAKE vs BLOCKS - Pool de hilos para trabajo por tick
+// ============================================================
+// Reparte un rango [0, count) entre hilos que viven toda la partida
+// (se crean una sola vez). El hilo que llama también trabaja y no
+// vuelve hasta que el rango está completo.
+//
+// - El trabajo se pasa como puntero a función + contexto: lanzar un
+//   rango no reserva memoria (nada de std::function).
+// - Los bloques se toman con un contador atómico: no importa qué hilo
+//   hace cada bloque, así que el resultado es el mismo con 1 o N hilos
+//   siempre que cada índice solo escriba sus propios datos.
+// - Rangos pequeños se ejecutan directamente en el hilo que llama.
+// ============================================================
+#pragma once
+
+#include <algorithm>          // min, max
+#include <atomic>             // Contadores compartidos
+#include <condition_variable> // Despertar a los hilos
+#include <mutex>
+#include <thread>
+#include <vector>             // Hilos
+
+class WorkerPool {
+public:
+    // ========== CONSTRUCTOR ==========
+    // 'threads' cuenta también al hilo que llama (0: uno por núcleo)
+    explicit WorkerPool(unsigned threads = 0) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned i = 1; i < threads; i++) {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Hilos que trabajan en cada rango (incluido el que llama)
+    unsigned size() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    // ========== RANGO PARALELO ==========
+    // Llama a job(begin, end) sobre bloques de al menos 'minChunk'
+    // índices hasta cubrir [0, count)
+    template <class Job>
+    void parallelFor(int count, int minChunk, Job& job) {
+        if (count <= 0) return;
+        int chunk = std::max(minChunk, (count + int(size()) * 4 - 1) / (int(size()) * 4));
+        if (workers.empty() || count <= chunk) {
+            job(0, count);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task.run = [](void* context, int begin, int end) { (*static_cast<Job*>(context))(begin, end); };
+            task.context = &job;
+            task.count = count;
+            task.chunk = chunk;
+            nextIndex.store(0, std::memory_order_relaxed);
+            pendingWorkers = static_cast<int>(workers.size());
+            generation++;
+        }
+        wake.notify_all();
+        runChunks();
+        // Esperar a que todos los hilos terminen (ya no tocan 'task' al salir)
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return pendingWorkers == 0; });
+    }
+
+private:
+    struct Task {
+        void (*run)(void*, int, int) = nullptr;
+        void* context = nullptr;
+        int count = 0;
+        int chunk = 1;
+    };
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;       // Hay un rango nuevo (o hay que salir)
+    std::condition_variable done;       // Un hilo terminó su parte
+    Task task;
+    std::atomic<int> nextIndex{0};      // Primer índice sin repartir
+    unsigned generation = 0;            // Cambia con cada rango
+    int pendingWorkers = 0;             // Hilos que aún no terminaron el rango actual
+    bool stopping = false;
+
+    // Toma bloques hasta agotar el rango
+    void runChunks() {
+        for (;;) {
+            int begin = nextIndex.fetch_add(task.chunk, std::memory_order_relaxed);
+            if (begin >= task.count) return;
+            task.run(task.context, begin, std::min(begin + task.chunk, task.count));
+        }
+    }
+
+    void workerLoop() {
+        unsigned seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            runChunks();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                pendingWorkers--;
+            }
+            done.notify_one();
+        }
+    }
+};
@@ -0,0 +1,165 @@
+// ============================================================
+// SNAKE vs BLOCKS - Pruebas del modo arena
+// ============================================================
+// - arena_deterministic: la simulación da el mismo resultado en un hilo y
+//   repartida entre los hilos de WorkerPool.
+// - Una prueba por regla de conflicto de arena.hpp, con dos serpientes de
+//   jugador puestas a mano en un tablero chico y un solo tick: choque de
+//   cabezas en la misma celda, cabezas que se cruzan, choque contra un
+//   cuerpo, entrar a una cola que se mueve y a una que se queda porque su
+//   serpiente crece.
+// ============================================================
+
+#include "test_helpers.hpp"
+#include "../src/arena.hpp"
+#include <algorithm>          // fill
+#include <initializer_list>   // Cuerpos de las serpientes puestas a mano
+#include <memory>             // unique_ptr (arena)
+#include <utility>            // pair
+
+using SmallArena = BasicArena<16, 12>;
+const int UP = 0, RIGHT = 1, DOWN = 2, LEFT = 3;
+
+// Arena de dos jugadores con el tablero vacío (sin obstáculos, manzanas ni
+// serpientes); las pruebas colocan lo suyo con placeArenaSnake()
+std::unique_ptr<SmallArena> emptyArena() {
+    auto arena = std::make_unique<SmallArena>(0, 2, 1);
+    std::fill(arena->cells.begin(), arena->cells.end(), CELL_EMPTY);
+    std::fill(arena->towardHead.begin(), arena->towardHead.end(), SmallArena::NONE);
+    arena->apples.clear();
+    arena->obstacles.clear();
+    for (SmallArena::ArenaSnake& s : arena->snakes) s.alive = false;
+    arena->aliveCount = 0;
+    return arena;
+}
+
+// Serpiente 'id' con el cuerpo dado (de la cabeza a la cola) que avanza
+// hacia 'direction'
+void placeArenaSnake(SmallArena& arena, int id, std::initializer_list<std::pair<int, int>> body, int direction) {
+    SmallArena::ArenaSnake& s = arena.snakes[id];
+    int toHead = SmallArena::NONE;
+    s.length = 0;
+    for (const std::pair<int, int>& segment : body) {
+        int cell = SmallArena::cellIndex(segment.first, segment.second);
+        arena.cells[cell] = CELL_SNAKE;
+        arena.owner[cell] = static_cast<unsigned short>(id);
+        arena.towardHead[cell] = toHead;
+        if (s.length++ == 0) s.head = cell;
+        s.tail = cell;
+        toHead = cell;
+    }
+    s.direction = s.nextDirection = direction;
+    s.alive = true;
+    arena.aliveCount++;
+    arena.occupancy.load(arena.cells, minimapLayer);
+}
+
+// Estado de una serpiente después del tick: viva o no y, si sigue viva,
+// dónde quedaron la cabeza y la cola
+bool snakeIs(const char* test, const SmallArena& arena, int id, bool alive, int headX = 0, int headY = 0,
+             int tailX = 0, int tailY = 0) {
+    const SmallArena::ArenaSnake& s = arena.snakes[id];
+    bool ok = s.alive == alive;
+    if (ok && alive) {
+        ok = s.head == SmallArena::cellIndex(headX, headY) && s.tail == SmallArena::cellIndex(tailX, tailY) &&
+             arena.cells[s.tail] == CELL_SNAKE && arena.owner[s.tail] == id;
+    }
+    if (!ok) {
+        std::cerr << test << ": la serpiente " << id << (s.alive ? " sigue viva" : " murió") << " con la cabeza en "
+                  << s.head % SmallArena::BOARD_COLS << "," << s.head / SmallArena::BOARD_COLS << " y la cola en "
+                  << s.tail % SmallArena::BOARD_COLS << "," << s.tail / SmallArena::BOARD_COLS << std::endl;
+    }
+    return ok;
+}
+
+// La arena da el mismo resultado en un hilo y repartida entre varios
+bool arenaIsDeterministic() {
+    auto serial = std::make_unique<Arena>(400, 0, 99);
+    auto parallel = std::make_unique<Arena>(400, 0, 99);
+    WorkerPool pool(4);
+    for (int i = 0; i < 600; i++) {
+        serial->tick();
+        parallel->tick(&pool);
+        if (serial->cells != parallel->cells || serial->aliveCount != parallel->aliveCount) {
+            std::cerr << "arena: distinto resultado con 4 hilos en el tick " << i + 1 << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Dos cabezas eligen la misma celda: mueren las dos y la celda queda sin
+// dueño (sus cuerpos pasan a manzanas)
+bool headOnSameCell() {
+    auto arena = emptyArena();
+    placeArenaSnake(*arena, 0, {{4, 5}, {3, 5}, {2, 5}}, RIGHT);
+    placeArenaSnake(*arena, 1, {{6, 5}, {7, 5}, {8, 5}}, LEFT);
+    arena->tick();
+    if (!snakeIs("head_on", *arena, 0, false) || !snakeIs("head_on", *arena, 1, false)) return false;
+    if (arena->cells[SmallArena::cellIndex(5, 5)] == CELL_SNAKE || !arena->finished ||
+        arena->winner != SmallArena::NONE) {
+        std::cerr << "head_on: la celda del choque o el fin de la ronda quedaron mal" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Cabezas vecinas que se cruzan: cada una entra a la cabeza de la otra
+// (no es su cola), mueren las dos
+bool headSwap() {
+    auto arena = emptyArena();
+    placeArenaSnake(*arena, 0, {{5, 5}, {4, 5}, {3, 5}}, RIGHT);
+    placeArenaSnake(*arena, 1, {{6, 5}, {7, 5}, {8, 5}}, LEFT);
+    arena->tick();
+    return snakeIs("head_swap", *arena, 0, false) && snakeIs("head_swap", *arena, 1, false);
+}
+
+// Entrar al medio de otro cuerpo: muere solo la que entra
+bool bodyHit() {
+    auto arena = emptyArena();
+    placeArenaSnake(*arena, 0, {{5, 4}, {5, 3}, {5, 2}}, DOWN);
+    placeArenaSnake(*arena, 1, {{6, 5}, {5, 5}, {4, 5}, {3, 5}}, RIGHT);
+    arena->tick();
+    return snakeIs("body_hit", *arena, 0, false) && snakeIs("body_hit", *arena, 1, true, 7, 5, 4, 5);
+}
+
+// La cola de una serpiente que no crece se mueve en el mismo tick: otra
+// cabeza puede entrar ahí
+bool leavingTailIsFree() {
+    auto arena = emptyArena();
+    placeArenaSnake(*arena, 0, {{5, 4}, {5, 3}, {5, 2}}, DOWN);
+    placeArenaSnake(*arena, 1, {{7, 5}, {6, 5}, {5, 5}}, RIGHT);
+    arena->tick();
+    return snakeIs("leaving_tail", *arena, 0, true, 5, 5, 5, 3) &&
+           snakeIs("leaving_tail", *arena, 1, true, 8, 5, 6, 5);
+}
+
+// Si la dueña de la cola come una manzana en este tick la cola no se
+// mueve: la que entra muere y la otra crece
+bool growingTailStays() {
+    auto arena = emptyArena();
+    placeArenaSnake(*arena, 0, {{5, 4}, {5, 3}, {5, 2}}, DOWN);
+    placeArenaSnake(*arena, 1, {{7, 5}, {6, 5}, {5, 5}}, RIGHT);
+    arena->placeApple(SmallArena::cellIndex(8, 5));
+    arena->tick();
+    if (!snakeIs("growing_tail", *arena, 0, false) || !snakeIs("growing_tail", *arena, 1, true, 8, 5, 5, 5)) {
+        return false;
+    }
+    if (arena->snakes[1].length != 4 || arena->snakes[1].applesEaten != 1) {
+        std::cerr << "growing_tail: largo " << arena->snakes[1].length << " después de comer" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    const TestCase tests[] = {
+        {"arena_deterministic", arenaIsDeterministic},
+        {"head_on", headOnSameCell},
+        {"head_swap", headSwap},
+        {"body_hit", bodyHit},
+        {"leaving_tail", leavingTailIsFree},
+        {"growing_tail", growingTailStays},
+    };
+    return runTests(tests);
+}
@@ -0,0 +1,88 @@
+// ============================================================
+// SNAKE vs BLOCKS - Pruebas de la simulación
+// ============================================================
+// Reglas de BasicGameState que no dependen del dibujo: la serpiente
+// rápida da varios pasos por tick sin saltarse celdas, y desde el nivel 80
+// la velocidad tiene tope para no perder pasos.
+// ============================================================
+
+#include "test_helpers.hpp"
+
+// A gran velocidad hay varios pasos por tick y cada uno come y choca:
+// ni las manzanas ni el obstáculo del camino se saltan. Y los primeros
+// niveles siguen el ritmo de siempre (nivel 1: un paso cada 10 ticks).
+bool fastSnakeChecksEveryCell() {
+    GameState game(1);
+    for (int timer : {TIMER_APPLE_SPAWN, TIMER_POWERUP_SPAWN, TIMER_OBSTACLE_SPAWN}) game.timers.cancel(timer);
+    int steps = 0;
+    for (int tick = 0; tick < 100; tick++) {
+        SnakeSegment before = game.snake[0];
+        game.update(0.016f);
+        steps += game.snake[0].x - before.x;
+    }
+    if (steps != 10) {
+        std::cerr << "velocidad: " << steps << " pasos en 100 ticks de nivel 1 (se esperaban 10)" << std::endl;
+        return false;
+    }
+
+    game.reset(1);
+    for (int timer : {TIMER_APPLE_SPAWN, TIMER_POWERUP_SPAWN, TIMER_OBSTACLE_SPAWN}) game.timers.cancel(timer);
+    game.applesEaten = 290;    // Nivel 30: 187.5 celdas/s, 3 pasos por tick
+    placeCells(game, 2, 22, 15, 1, 0, CELL_APPLE);
+    placeCells(game, 1, 30, 15, 0, 0, CELL_OBSTACLE);
+    int apples = 0, ticks = 0;
+    while (!game.gameOver && ticks < 10) {
+        game.update(0.016f);
+        ticks++;
+        for (int i = 0; i < game.eventCount; i++) apples += game.events[i].type == EVENT_APPLE_EATEN;
+    }
+    if (apples != 2 || game.deathCause != DEATH_OBSTACLE || ticks != 4 || game.snake[0].x != 29 ||
+        game.snake.size() != 3) {
+        std::cerr << "velocidad: " << apples << " manzanas, muerte " << game.deathCause << " en el tick " << ticks
+                  << " con la cabeza en x=" << game.snake[0].x << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Desde el nivel 80 la velocidad queda en MAX_CELLS_PER_SECOND: los pasos
+// de cada tick caben en MAX_STEPS_PER_TICK y la serpiente avanza lo que
+// dice cellsPerSecond, sin perder celdas ni saltarse comprobaciones
+bool topSpeedKeepsEveryStep() {
+    GameState game(1);
+    for (int timer : {TIMER_APPLE_SPAWN, TIMER_POWERUP_SPAWN, TIMER_OBSTACLE_SPAWN}) game.timers.cancel(timer);
+    game.applesEaten = 990;    // Nivel 100: 625 celdas/s sin el tope
+    placeCells(game, 7, 21, 15, 1, 0, CELL_APPLE);
+    placeCells(game, 1, 37, 15, 0, 0, CELL_OBSTACLE);
+    int apples = 0, ticks = 0, steps = 0;
+    float expected = 0;
+    while (!game.gameOver && ticks < 10) {
+        SnakeSegment before = game.snake[0];
+        game.update(0.016f);
+        ticks++;
+        if (!game.gameOver) {
+            steps += game.snake[0].x - before.x;
+            expected += game.cellsPerSecond * 0.016f;
+        }
+        for (int i = 0; i < game.eventCount; i++) apples += game.events[i].type == EVENT_APPLE_EATEN;
+    }
+    if (game.cellsPerSecond != GameState::MAX_CELLS_PER_SECOND || steps != static_cast<int>(expected + 0.5f)) {
+        std::cerr << "tope: " << steps << " pasos a " << game.cellsPerSecond << " celdas/s (se esperaban "
+                  << expected << ")" << std::endl;
+        return false;
+    }
+    if (apples != 7 || game.deathCause != DEATH_OBSTACLE || ticks != 3 || game.snake[0].x != 36) {
+        std::cerr << "tope: " << apples << " manzanas, muerte " << game.deathCause << " en el tick " << ticks
+                  << " con la cabeza en x=" << game.snake[0].x << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    const TestCase tests[] = {
+        {"fast_snake_checks_every_cell", fastSnakeChecksEveryCell},
+        {"top_speed_keeps_every_step", topSpeedKeepsEveryStep},
+    };
+    return runTests(tests);
+}
@@ -0,0 +1,299 @@
+// ============================================================
+// SNAKE vs BLOCKS - Pruebas con imágenes de referencia
+// ============================================================
+// Pruebas del dibujo (las de cada subsistema están en tests/*_test.cpp):
+// - blend: la mezcla SIMD coincide con la fórmula de referencia.
+// - paintBoard: el dibujo incremental queda igual que draw().
+// - grid: el tablero como textura queda igual que por entidades.
+// - imágenes: cada escena coincide píxel a píxel con tests/golden/*.ppm.
+// No necesita ventana ni GPU.
+//
+// Uso:
+//   golden_test.exe [--update] [--dir=tests/golden]
+//
+// --update vuelve a generar las imágenes de referencia (después de un
+// cambio visual intencional). Si una escena no coincide se guarda lo
+// dibujado como <escena>.actual.ppm junto a la referencia.
+// ============================================================
+
+#include "test_helpers.hpp"
+#include "../src/software_renderer.hpp"
+#include "../src/arena.hpp"
+#include <cstdio>             // FILE*, fopen
+#include <iostream>           // Salida por consola
+#include <memory>             // unique_ptr (arena)
+#include <string>
+#include <vector>
+
+// Escala de las imágenes de referencia (la mitad de la pantalla)
+const float GOLDEN_SCALE = 0.5f;
+
+// ============================================================
+// ESCENAS
+// ============================================================
+// Las de la partida normal se construyen directamente (sin simular) para
+// que solo cambien si cambia el dibujo, no las reglas del juego. La
+// arena se simula con semilla fija.
+
+// Tablero en el modo normal (un quad por entidad) o como textura
+template <class Board>
+void drawBoard(Board& board, Renderer& renderer, bool grid) {
+    if (!grid) {
+        board.draw(renderer);
+        return;
+    }
+    BoardTexture texture(Board::BOARD_COLS, Board::BOARD_ROWS);
+    board.drawGrid(renderer, texture);
+}
+
+// Tablero estándar a mitad de partida con dos power-ups activos
+void standardScene(Renderer& renderer, bool grid) {
+    GameState game(11);
+    placeSnake(game, 24, 8, 27);
+    placeCells(game, 6, 3, 2, 7, 5, CELL_APPLE);
+    placeCells(game, 12, 5, 20, 3, 1, CELL_OBSTACLE);
+    game.powerUps.push_back(PowerUp(2, 27, DOUBLE_SCORE));
+    game.cells[GameState::cellIndex(2, 27)] = powerUpCell(DOUBLE_SCORE);
+    game.powerUps.push_back(PowerUp(37, 3, MAGNET));
+    game.cells[GameState::cellIndex(37, 3)] = powerUpCell(MAGNET);
+    game.score = 460;
+    game.applesEaten = 23;
+    game.speedLevel = 3;
+    game.activatePowerUp(WALL_PASS);
+    game.activatePowerUp(DOUBLE_SCORE);
+    renderer.clear(sf::Color::Black);
+    drawBoard(game, renderer, grid);
+    game.drawUI(renderer);
+}
+
+// Tablero pequeño recién empezado (celdas grandes, panel sin power-ups)
+void smallScene(Renderer& renderer, bool grid) {
+    SmallGameState game(3);
+    placeCells(game, 3, 4, 3, 5, 4, CELL_APPLE);
+    renderer.clear(sf::Color::Black);
+    drawBoard(game, renderer, grid);
+    game.drawUI(renderer);
+}
+
+// Tablero grande lleno de obstáculos con MAGNET activo
+void largeScene(Renderer& renderer, bool grid) {
+    LargeGameState game(29);
+    placeSnake(game, 40, 20, 64);
+    placeCells(game, 40, 1, 1, 13, 7, CELL_OBSTACLE);
+    placeCells(game, 9, 6, 40, 11, 3, CELL_APPLE);
+    game.score = 12345;
+    game.applesEaten = 101;
+    game.speedLevel = 11;
+    game.activatePowerUp(MAGNET);
+    game.occupancy.load(game.cells, minimapLayer);
+    renderer.clear(sf::Color::Black);
+    drawBoard(game, renderer, grid);
+    game.drawUI(renderer);
+}
+
+// Arena con 120 bots y un jugador quieto tras 200 movimientos
+void arenaScene(Renderer& renderer, bool grid) {
+    auto arena = std::make_unique<Arena>(120, 1, 7);
+    WorkerPool pool(3);
+    for (int i = 0; i < 200; i++) arena->tick(&pool);
+    renderer.clear(sf::Color::Black);
+    drawBoard(*arena, renderer, grid);
+    arena->drawUI(renderer);
+}
+
+// ============================================================
+// IMÁGENES PPM
+// ============================================================
+
+// Lee un PPM binario (P6) como RGB; false si no existe o es inválido
+bool loadPpm(const std::string& path, unsigned& width, unsigned& height, std::vector<unsigned char>& rgb) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    int maxValue = 0;
+    bool ok = std::fscanf(file, "P6 %u %u %d", &width, &height, &maxValue) == 3 && maxValue == 255 &&
+              std::fgetc(file) != EOF;
+    if (ok) {
+        rgb.resize(static_cast<std::size_t>(width) * height * 3);
+        ok = std::fread(rgb.data(), 1, rgb.size(), file) == rgb.size();
+    }
+    std::fclose(file);
+    return ok;
+}
+
+// Compara el buffer con la referencia; devuelve los píxeles distintos
+// (-1 si la referencia no existe o tiene otro tamaño)
+long comparePpm(const SoftwareRenderer& frame, const std::string& path) {
+    unsigned width = 0, height = 0;
+    std::vector<unsigned char> rgb;
+    if (!loadPpm(path, width, height, rgb) || width != frame.width() || height != frame.height()) return -1;
+    long differences = 0;
+    for (unsigned y = 0; y < height; y++) {
+        for (unsigned x = 0; x < width; x++) {
+            sf::Color c = frame.pixel(x, y);
+            const unsigned char* expected = &rgb[(static_cast<std::size_t>(y) * width + x) * 3];
+            if (c.r != expected[0] || c.g != expected[1] || c.b != expected[2]) differences++;
+        }
+    }
+    return differences;
+}
+
+// ============================================================
+// PRUEBAS DEL RASTERIZADOR
+// ============================================================
+
+// La mezcla SIMD y la escalar deben dar el mismo resultado que la
+// fórmula de referencia en todos los anchos (colas de 0 a 3 píxeles)
+bool blendMatchesReference() {
+    SoftwareRenderer frame(37, 4);
+    bool ok = true;
+    for (int alpha = 1; alpha < 255 && ok; alpha += 7) {
+        for (unsigned y = 0; y < 4; y++) {
+            for (unsigned x = 0; x < 37; x++) {
+                sf::Color background((x * 7) & 0xFF, (y * 60 + x) & 0xFF, (x * 13 + alpha) & 0xFF, 255);
+                frame.fillRect(float(x), float(y), 1, 1, background);
+            }
+        }
+        sf::Color source(200, 17, 90, static_cast<sf::Uint8>(alpha));
+        frame.fillRect(1, 0, 35, 4, source);
+        for (unsigned y = 0; y < 4 && ok; y++) {
+            for (unsigned x = 1; x < 36; x++) {
+                sf::Color d((x * 7) & 0xFF, (y * 60 + x) & 0xFF, (x * 13 + alpha) & 0xFF, 255);
+                auto mix = [&](int s, int t) { return (s * alpha + t * (255 - alpha) + 127) / 255; };
+                sf::Color expected(mix(source.r, d.r), mix(source.g, d.g), mix(source.b, d.b));
+                sf::Color got = frame.pixel(x, y);
+                if (got.r != expected.r || got.g != expected.g || got.b != expected.b || got.a != 255) {
+                    std::cerr << "blend: alfa " << alpha << " en (" << x << ", " << y << ")" << std::endl;
+                    ok = false;
+                    break;
+                }
+            }
+        }
+    }
+    return ok;
+}
+
+// paintBoard() sobre un destino que nunca se limpia debe quedar igual que
+// draw() en un frame nuevo durante partidas enteras (reinicios,
+// OBSTACLE_DESTROYER y MAGNET incluidos)
+template <class Game>
+bool incrementalMatchesFull(const char* name, float scale) {
+    unsigned width = static_cast<unsigned>(SCREEN_WIDTH * scale);
+    unsigned height = static_cast<unsigned>(SCREEN_HEIGHT * scale);
+    SoftwareRenderer layer(width, height, scale), fresh(width, height, scale);
+    Game game(5);
+    unsigned input = 12345;
+    for (int tick = 1; tick <= 6000; tick++) {
+        if (nextRandom(input) % 8 == 0) {
+            int turn = (game.direction + (input & 16 ? 1 : 3)) % 4;
+            game.nextDirection = turn;
+        }
+        if (tick % 1500 == 0) game.activatePowerUp(OBSTACLE_DESTROYER);
+        if (tick % 700 == 0) game.activatePowerUp(MAGNET);
+        game.update(0.016f);
+        if (game.gameOver) game.reset(tick);
+        game.paintBoard(layer);
+        if (tick % 25 != 0) continue;
+        fresh.clear(sf::Color::Black);
+        game.draw(fresh);
+        long differences = 0;
+        for (unsigned i = 0; i < width * height; i++) differences += layer.pixels()[i] != fresh.pixels()[i];
+        if (differences > 0) {
+            std::cerr << "paintBoard: " << name << " distinto de draw() en el tick " << tick << " ("
+                      << differences << " píxeles)" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================
+// PUNTO DE ENTRADA
+// ============================================================
+
+struct Scene {
+    const char* name;
+    void (*render)(Renderer&, bool grid);
+};
+
+// --render=grid debe dar exactamente la misma imagen que el dibujo por
+// entidades, a la escala de las referencias y a tamaño real
+bool gridMatchesCells(const Scene& scene) {
+    for (float scale : {GOLDEN_SCALE, 1.0f}) {
+        unsigned width = static_cast<unsigned>(SCREEN_WIDTH * scale);
+        unsigned height = static_cast<unsigned>(SCREEN_HEIGHT * scale);
+        SoftwareRenderer cells(width, height, scale), grid(width, height, scale);
+        scene.render(cells, false);
+        scene.render(grid, true);
+        long differences = 0;
+        for (unsigned i = 0; i < width * height; i++) differences += cells.pixels()[i] != grid.pixels()[i];
+        if (differences > 0) {
+            std::cerr << "grid: " << scene.name << " a escala " << scale << " tiene " << differences
+                      << " píxeles distintos" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    bool update = false;
+    std::string dir = "tests/golden";
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--update") update = true;
+        else if (arg.rfind("--dir=", 0) == 0) dir = arg.substr(6);
+        else {
+            std::cerr << "Uso: golden_test [--update] [--dir=tests/golden]" << std::endl;
+            return 1;
+        }
+    }
+
+    calculateScaling();
+    int failures = 0;
+
+    if (!blendMatchesReference()) failures++;
+    if (!incrementalMatchesFull<GameState>("standard", 1.0f)) failures++;
+    if (!incrementalMatchesFull<SmallGameState>("small", GOLDEN_SCALE)) failures++;
+    if (!incrementalMatchesFull<LargeGameState>("large", GOLDEN_SCALE)) failures++;
+
+    const Scene scenes[] = {
+        {"standard", standardScene},
+        {"small", smallScene},
+        {"large", largeScene},
+        {"arena", arenaScene},
+    };
+    SoftwareRenderer frame(static_cast<unsigned>(SCREEN_WIDTH * GOLDEN_SCALE),
+                           static_cast<unsigned>(SCREEN_HEIGHT * GOLDEN_SCALE), GOLDEN_SCALE);
+    for (const Scene& scene : scenes) {
+        if (!gridMatchesCells(scene)) failures++;
+    }
+    for (const Scene& scene : scenes) {
+        scene.render(frame, false);
+        std::string path = dir + "/" + scene.name + ".ppm";
+        if (update) {
+            if (!frame.savePpm(path)) {
+                std::cerr << "Error: no se pudo escribir " << path << std::endl;
+                return 1;
+            }
+            std::cout << "actualizada " << path << std::endl;
+            continue;
+        }
+        long differences = comparePpm(frame, path);
+        if (differences == 0) {
+            std::cout << "ok   " << scene.name << std::endl;
+            continue;
+        }
+        std::string actual = dir + "/" + scene.name + ".actual.ppm";
+        frame.savePpm(actual);
+        if (differences < 0) std::cout << "FAIL " << scene.name << ": falta " << path << " o tiene otro tamaño";
+        else std::cout << "FAIL " << scene.name << ": " << differences << " píxeles distintos";
+        std::cout << " (dibujado en " << actual << ")" << std::endl;
+        failures++;
+    }
+
+    if (failures > 0) {
+        std::cout << failures << " prueba(s) fallaron" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+// ============================================================
+// SNAKE vs BLOCKS - Pruebas del minimapa
+// ============================================================
+// La pirámide de ocupación, actualizada celda por celda durante partidas
+// enteras (y en la arena), coincide con contar el tablero de nuevo, y el
+// minimapa recoloreado por bloques queda igual que uno pintado desde cero.
+// ============================================================
+
+#include "test_helpers.hpp"
+#include "../src/arena.hpp"
+#include <memory>             // unique_ptr (arena)
+
+// La pirámide del minimapa, actualizada celda por celda, coincide en
+// todos sus niveles con contar el tablero de nuevo, y el minimapa que se
+// recolorea por bloques queda igual que uno pintado desde cero
+template <class Board>
+bool occupancyMatchesBoard(const Board& board, Minimap& minimap, const char* name, int tick) {
+    using Pyramid = decltype(board.occupancy);
+    static Pyramid fresh;
+    fresh.load(board.cells, minimapLayer);
+    for (int level = 0; level < Pyramid::LEVELS; level++) {
+        for (int by = 0; by < Pyramid::levelRows(level); by++) {
+            for (int bx = 0; bx < Pyramid::levelCols(level); bx++) {
+                const auto& a = board.occupancy.block(level, bx, by);
+                const auto& b = fresh.block(level, bx, by);
+                for (int l = 0; l < LAYER_COUNT; l++) {
+                    if (a.layer[l] == b.layer[l]) continue;
+                    std::cerr << "minimapa: " << name << " nivel " << level << " bloque (" << bx << ", " << by
+                              << ") capa " << l << " cuenta " << a.layer[l] << " en vez de " << b.layer[l]
+                              << " en el tick " << tick << std::endl;
+                    return false;
+                }
+            }
+        }
+    }
+    Minimap repainted;
+    repainted.sync(fresh);
+    sf::Vector2u size = repainted.image().getSize();
+    for (unsigned y = 0; y < size.y; y++) {
+        for (unsigned x = 0; x < size.x; x++) {
+            if (minimap.image().image().getPixel(x, y) == repainted.image().image().getPixel(x, y)) continue;
+            std::cerr << "minimapa: " << name << " texel (" << x << ", " << y << ") desactualizado en el tick "
+                      << tick << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool minimapIsIncremental() {
+    LargeGameState game(8);
+    Minimap minimap;
+    unsigned input = 777;
+    for (int tick = 1; tick <= 6000; tick++) {
+        if (nextRandom(input) % 8 == 0) game.nextDirection = (game.direction + (input & 16 ? 1 : 3)) % 4;
+        if (tick % 1500 == 0) game.activatePowerUp(OBSTACLE_DESTROYER);
+        if (tick % 700 == 0) game.activatePowerUp(MAGNET);
+        game.update(0.016f);
+        if (game.gameOver) game.reset(tick);
+        minimap.sync(game.occupancy);
+        if (tick % 50 == 0 && !occupancyMatchesBoard(game, minimap, "large", tick)) return false;
+    }
+
+    auto arena = std::make_unique<Arena>(300, 0, 5);
+    Minimap arenaMap;
+    for (int tick = 1; tick <= 400; tick++) {
+        arena->tick();
+        if (arena->finished) arena->reset(tick);
+        arenaMap.sync(arena->occupancy);
+        if (tick % 40 == 0 && !occupancyMatchesBoard(*arena, arenaMap, "arena", tick)) return false;
+    }
+    return true;
+}
+
+int main() {
+    const TestCase tests[] = {
+        {"minimap_is_incremental", minimapIsIncremental},
+    };
+    return runTests(tests);
+}
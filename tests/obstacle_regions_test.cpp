@@ -0,0 +1,84 @@
+// ============================================================
+// SNAKE vs BLOCKS - Pruebas de las regiones de obstáculos
+// ============================================================
+// ObstacleRegions::wouldSeal() dice lo mismo que un flood fill completo
+// mientras el tablero se llena de obstáculos, en varios tamaños.
+// ============================================================
+
+#include "test_helpers.hpp"
+#include "../src/obstacle_regions.hpp"
+#include <algorithm>          // fill
+#include <vector>
+
+// Celdas libres alcanzables desde 'start' (flood fill por 4 vecinos)
+template <class Regions, int COLS, int ROWS>
+int reachableCells(const Regions& regions, int start, std::vector<int>& stack, std::vector<char>& seen) {
+    std::fill(seen.begin(), seen.end(), 0);
+    stack.assign(1, start);
+    seen[start] = 1;
+    int count = 0;
+    while (!stack.empty()) {
+        int cell = stack.back();
+        stack.pop_back();
+        count++;
+        int x = cell % COLS, y = cell / COLS;
+        const int dx[4] = {0, 1, 0, -1}, dy[4] = {-1, 0, 1, 0};
+        for (int d = 0; d < 4; d++) {
+            int nx = x + dx[d], ny = y + dy[d];
+            if (regions.blocked(nx, ny) || seen[ny * COLS + nx]) continue;
+            seen[ny * COLS + nx] = 1;
+            stack.push_back(ny * COLS + nx);
+        }
+    }
+    return count;
+}
+
+// wouldSeal() dice lo mismo que un flood fill completo para cada celda
+// candidata mientras el tablero se llena de obstáculos
+template <int COLS, int ROWS>
+bool obstacleRegionsMatchFloodFill(const char* name) {
+    ObstacleRegions<COLS, ROWS> regions;
+    std::vector<int> stack;
+    std::vector<char> seen(COLS * ROWS);
+    unsigned random = 2024;
+    for (int round = 0; round < 4; round++) {
+        regions.clear();
+        int freeCells = COLS * ROWS;
+        for (int attempt = 0; attempt < COLS * ROWS * 3; attempt++) {
+            int cell = nextRandom(random) % (COLS * ROWS);
+            int x = cell % COLS, y = cell / COLS;
+            if (regions.blocked(x, y)) continue;
+            bool seals = regions.wouldSeal(x, y);
+
+            // Probar de verdad: agregar en una copia y contar lo alcanzable
+            ObstacleRegions<COLS, ROWS> trial = regions;
+            trial.add(x, y);
+            int start = -1;
+            for (int i = 0; i < COLS * ROWS && start < 0; i++) {
+                if (!trial.blocked(i % COLS, i / COLS)) start = i;
+            }
+            bool connected = start < 0 || reachableCells<ObstacleRegions<COLS, ROWS>, COLS, ROWS>(
+                                              trial, start, stack, seen) == freeCells - 1;
+            if (seals == connected) {
+                std::cerr << "obstáculos: " << name << " wouldSeal(" << x << ", " << y << ") = " << seals
+                          << " con " << COLS * ROWS - freeCells << " obstáculos" << std::endl;
+                return false;
+            }
+            if (!seals) {
+                regions.add(x, y);
+                freeCells--;
+            }
+        }
+    }
+    return true;
+}
+
+int main() {
+    const TestCase tests[] = {
+        {"obstacle_regions_small", [] { return obstacleRegionsMatchFloodFill<20, 15>("small"); }},
+        {"obstacle_regions_standard", [] { return obstacleRegionsMatchFloodFill<40, 30>("standard"); }},
+        {"obstacle_regions_large", [] { return obstacleRegionsMatchFloodFill<64, 48>("large"); }},
+        {"obstacle_regions_column", [] { return obstacleRegionsMatchFloodFill<1, 9>("column"); }},
+    };
+    return runTests(tests);
+}
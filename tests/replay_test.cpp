@@ -0,0 +1,124 @@
+// ============================================================
+// SNAKE vs BLOCKS - Pruebas de repeticiones y avance rápido
+// ============================================================
+// - FastForward nunca pasa del presupuesto del frame y vuelve al
+//   multiplicador elegido cuando hay margen.
+// - Una partida grabada se reproduce igual (también desde archivo) y un
+//   archivo dañado se rechaza.
+// ============================================================
+
+#include "test_helpers.hpp"
+#include "../src/autopilot.hpp"
+#include "../src/replay.hpp"
+#include "../src/fast_forward.hpp"
+#include <cstdio>             // fopen, remove
+#include <filesystem>         // Carpeta temporal
+#include <string>
+
+// El avance rápido nunca pasa del presupuesto del frame: con ticks caros
+// baja el multiplicador y, cuando vuelven a ser baratos, sube hasta el
+// elegido. El reloj es simulado (cada tick lo adelanta 'tickCost').
+bool fastForwardKeepsBudget() {
+    const double budget = 0.010;
+    FastForward turbo(budget);
+    turbo.setLevel(FastForward::LEVEL_COUNT - 1);      // 100x
+    double clock = 0, tickCost = 0.0004;                // Entran 25 ticks por frame
+    auto now = [&clock] { return clock; };
+    auto step = [&clock, &tickCost] {
+        clock += tickCost;
+        return true;
+    };
+    for (int frame = 0; frame < 60; frame++) {
+        if (frame == 30) tickCost = 0.00002;             // Entrarían 500
+        double start = clock;
+        int ticks = turbo.run(step, now);
+        if (ticks < 1 || clock - start > budget + 1e-9) {
+            std::cerr << "avance rápido: " << ticks << " ticks en " << (clock - start) * 1000 << " ms en el frame "
+                      << frame << std::endl;
+            return false;
+        }
+        if (frame == 29 && (!turbo.limited() || turbo.effective() > 25)) {
+            std::cerr << "avance rápido: con ticks caros sigue en " << turbo.effective() << "x" << std::endl;
+            return false;
+        }
+    }
+    if (turbo.limited() || turbo.effective() != 100) {
+        std::cerr << "avance rápido: no volvió a 100x (" << turbo.effective() << "x)" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Una partida grabada, guardada y vuelta a leer, se reproduce igual con
+// avance rápido aunque el presupuesto corte los frames; un archivo dañado
+// se rechaza
+bool replayMatchesRecordedGame() {
+    GameState played(31);
+    ReplayRecording recording;
+    recording.start(played);
+    unsigned input = 777;
+    std::uint32_t ticks = 0;
+    while (!played.gameOver && ticks < 20000) {
+        nextRandom(input);
+        played.nextDirection = input % 16 == 0 ? (played.direction + (input & 16 ? 1 : 3)) % 4
+                                               : autopilotDirection(played);
+        recording.record(played.nextDirection);
+        played.update(TICK_SECONDS);
+        ticks++;
+    }
+
+    std::string path = (std::filesystem::temp_directory_path() / "golden_test.replay").string();
+    ReplayRecording loaded;
+    if (!recording.save(path) || !loaded.load(path)) {
+        std::cerr << "repetición: no se pudo guardar y leer " << path << std::endl;
+        return false;
+    }
+    if (loaded.ticks != ticks || loaded.changes.size() != recording.changes.size()) {
+        std::cerr << "repetición: se leyeron " << loaded.ticks << " ticks (se grabaron " << ticks << ")" << std::endl;
+        return false;
+    }
+
+    GameState replayed(1);
+    ReplayPlayer player;
+    player.start(loaded, replayed);
+    FastForward turbo(0.010);
+    turbo.setLevel(FastForward::LEVEL_COUNT - 1);
+    double clock = 0;
+    auto step = [&] {
+        clock += 0.0003;
+        if (replayed.gameOver || !player.apply(replayed)) return false;
+        replayed.update(TICK_SECONDS);
+        return true;
+    };
+    int frames = 0;
+    while (turbo.run(step, [&clock] { return clock; }) > 0) frames++;
+    if (player.ticksPlayed() != ticks || replayed.gameOver != played.gameOver || replayed.score != played.score ||
+        replayed.cells != played.cells) {
+        std::cerr << "repetición: distinta de la partida tras " << player.ticksPlayed() << " de " << ticks
+                  << " ticks (puntos " << replayed.score << " contra " << played.score << ")" << std::endl;
+        return false;
+    }
+
+    // Un byte cambiado en medio del archivo
+    if (std::FILE* file = std::fopen(path.c_str(), "r+b")) {
+        std::fseek(file, ReplayRecording::HEADER_SIZE + 4, SEEK_SET);
+        std::fputc(7, file);
+        std::fclose(file);
+    }
+    bool rejected = !loaded.load(path);
+    std::remove(path.c_str());
+    if (!rejected) {
+        std::cerr << "repetición: se aceptó un archivo dañado" << std::endl;
+        return false;
+    }
+    std::cout << "     " << ticks << " ticks en " << frames << " frames" << std::endl;
+    return true;
+}
+
+int main() {
+    const TestCase tests[] = {
+        {"fast_forward_keeps_budget", fastForwardKeepsBudget},
+        {"replay_matches_recorded_game", replayMatchesRecordedGame},
+    };
+    return runTests(tests);
+}
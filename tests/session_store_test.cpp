@@ -0,0 +1,243 @@
+// ============================================================
+// SNAKE vs BLOCKS - Pruebas del registro de partidas
+// ============================================================
+// SessionStore con el log y el índice en una carpeta temporal:
+// - torn_tail: un registro a medias al final del log (el proceso murió
+//   escribiendo) se descarta y el log queda alineado para los siguientes.
+// - damaged_record: un registro con CRC inválido en medio se salta.
+// - stale_index: con registros agregados después del índice, con el
+//   índice corrupto o con un log más corto que el índice, el top-K y la
+//   cuenta se reconstruyen desde el log.
+// - submit_not_blocked: miles de submit() seguidos no esperan al disco.
+// - write_failure: con el disco lleno a mitad de un lote (límite de tamaño
+//   de archivo), el log se corta en el último registro completo, el top-K
+//   solo tiene lo escrito y los lotes siguientes quedan alineados.
+// ============================================================
+
+#include "test_helpers.hpp"
+#include "../src/session_store.hpp"
+#include <algorithm>          // sort, min
+#include <chrono>             // Tiempo de cada submit()
+#include <cstdio>             // fopen, fwrite
+#include <filesystem>         // Carpeta temporal, tamaño del log
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#include <csignal>            // Ignorar SIGXFSZ
+#include <sys/resource.h>     // setrlimit (límite de tamaño de archivo)
+#endif
+
+const int TOP_COUNT = 10;
+
+// Carpeta vacía para una prueba
+std::string freshDirectory(const char* name) {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / (std::string("svb_sessions_") + name);
+    std::filesystem::remove_all(path);
+    return path.string();
+}
+
+// Partidas pseudoaleatorias reproducibles (timestamp = orden de llegada)
+std::vector<SessionRecord> makeRecords(int count, unsigned seed) {
+    std::vector<SessionRecord> records(count);
+    for (int i = 0; i < count; i++) {
+        records[i].score = static_cast<int>(nextRandom(seed) % 100000);
+        records[i].applesEaten = records[i].score / 10;
+        records[i].seed = seed;
+        records[i].timestamp = static_cast<std::uint32_t>(i);
+        records[i].cause = END_WALL;
+    }
+    return records;
+}
+
+// Escribe en el log (con su carpeta) y cierra el store: al destruirse
+// termina de escribir y guarda el índice
+void storeRecords(const std::string& directory, const std::vector<SessionRecord>& records) {
+    SessionStore store(directory, TOP_COUNT);
+    for (const SessionRecord& record : records) store.submit(record);
+}
+
+// Agrega bytes al final del log sin pasar por el store
+void appendToLog(const std::string& directory, const unsigned char* data, std::size_t size) {
+    std::FILE* file = std::fopen((directory + "/sessions.log").c_str(), "ab");
+    std::fwrite(data, 1, size, file);
+    std::fclose(file);
+}
+
+// Cambia un byte de un archivo del store
+void flipByte(const std::string& path, long offset) {
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    std::fseek(file, offset, SEEK_SET);
+    int byte = std::fgetc(file);
+    std::fseek(file, offset, SEEK_SET);
+    std::fputc(byte ^ 0x5A, file);
+    std::fclose(file);
+}
+
+// Reabre el store y compara la cuenta y el top-K con lo esperado
+bool reopenMatches(const char* test, const std::string& directory, const std::vector<SessionRecord>& expected) {
+    std::vector<SessionRecord> sorted = expected;
+    std::sort(sorted.begin(), sorted.end(), [](const SessionRecord& a, const SessionRecord& b) { return a.ranksAbove(b); });
+    sorted.resize(std::min<std::size_t>(sorted.size(), TOP_COUNT));
+
+    SessionStore store(directory, TOP_COUNT);
+    std::vector<SessionRecord> top = store.topScores();
+    if (store.sessionCount() != expected.size()) {
+        std::cerr << test << ": " << store.sessionCount() << " partidas (se esperaban " << expected.size() << ")"
+                  << std::endl;
+        return false;
+    }
+    if (top.size() != sorted.size() || store.bestScore() != (sorted.empty() ? 0 : sorted[0].score)) {
+        std::cerr << test << ": top-K de " << top.size() << " con récord " << store.bestScore() << std::endl;
+        return false;
+    }
+    for (std::size_t i = 0; i < top.size(); i++) {
+        if (top[i].score != sorted[i].score || top[i].timestamp != sorted[i].timestamp) {
+            std::cerr << test << ": puesto " << i + 1 << " es " << top[i].score << " (se esperaba "
+                      << sorted[i].score << ")" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================
+// PRUEBAS
+// ============================================================
+
+bool tornTailIsTruncated() {
+    std::string directory = freshDirectory("torn");
+    std::vector<SessionRecord> records = makeRecords(50, 1);
+    storeRecords(directory, records);
+
+    // El proceso murió a mitad del registro 51 (sin tocar el índice)
+    unsigned char partial[SessionFormat::RECORD_SIZE];
+    SessionFormat::encode(makeRecords(1, 2)[0], partial);
+    appendToLog(directory, partial, 13);
+    if (!reopenMatches("torn_tail", directory, records)) return false;
+    std::uintmax_t size = std::filesystem::file_size(directory + "/sessions.log");
+    if (size != records.size() * SessionFormat::RECORD_SIZE) {
+        std::cerr << "torn_tail: el log quedó con " << size << " bytes" << std::endl;
+        return false;
+    }
+
+    // Lo que se escribe después queda alineado (también sin índice)
+    std::vector<SessionRecord> more = makeRecords(5, 3);
+    for (SessionRecord& record : more) record.timestamp += 1000;
+    storeRecords(directory, more);
+    records.insert(records.end(), more.begin(), more.end());
+    std::filesystem::remove(directory + "/sessions.idx");
+    return reopenMatches("torn_tail", directory, records);
+}
+
+bool damagedRecordIsSkipped() {
+    std::string directory = freshDirectory("damaged");
+    std::vector<SessionRecord> records = makeRecords(40, 4);
+    storeRecords(directory, records);
+    std::filesystem::remove(directory + "/sessions.idx");
+    flipByte(directory + "/sessions.log", 7 * SessionFormat::RECORD_SIZE + 5);
+    records.erase(records.begin() + 7);
+    return reopenMatches("damaged_record", directory, records);
+}
+
+bool staleIndexIsRebuilt() {
+    std::string directory = freshDirectory("stale");
+    std::vector<SessionRecord> records = makeRecords(200, 5);
+    storeRecords(directory, records);
+
+    // Registros agregados después del último índice (con un récord nuevo)
+    std::vector<SessionRecord> late = makeRecords(20, 6);
+    late[9].score = 1000000;
+    for (SessionRecord& record : late) {
+        record.timestamp += 1000;
+        unsigned char bytes[SessionFormat::RECORD_SIZE];
+        SessionFormat::encode(record, bytes);
+        appendToLog(directory, bytes, sizeof(bytes));
+    }
+    records.insert(records.end(), late.begin(), late.end());
+    if (!reopenMatches("stale_index", directory, records)) return false;
+
+    // Índice corrupto: se ignora y se recorre todo el log
+    flipByte(directory + "/sessions.idx", SessionFormat::INDEX_HEADER_SIZE + 6);
+    if (!reopenMatches("stale_index", directory, records)) return false;
+
+    // Log más corto que lo que cubre el índice (se restauró uno viejo)
+    std::filesystem::resize_file(directory + "/sessions.log", 30 * SessionFormat::RECORD_SIZE);
+    records.resize(30);
+    return reopenMatches("stale_index", directory, records);
+}
+
+// submit() solo encola: mientras el hilo escritor vuelca lotes al disco,
+// ninguna llamada espera más que un cambio de contexto
+bool submitIsNotBlocked() {
+    const int COUNT = 200000;
+    const double MAX_SUBMIT_SECONDS = 0.05;
+    std::string directory = freshDirectory("bulk");
+    std::vector<SessionRecord> records = makeRecords(COUNT, 7);
+    double slowest = 0;
+    {
+        SessionStore store(directory, TOP_COUNT);
+        for (const SessionRecord& record : records) {
+            auto start = std::chrono::steady_clock::now();
+            store.submit(record);
+            slowest = std::max(slowest, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+    }
+    if (slowest > MAX_SUBMIT_SECONDS) {
+        std::cerr << "submit_not_blocked: un submit() tardó " << slowest * 1000 << " ms" << std::endl;
+        return false;
+    }
+    return reopenMatches("submit_not_blocked", directory, records);
+}
+
+bool writeFailureKeepsLogAligned() {
+#ifndef _WIN32
+    std::string directory = freshDirectory("full");
+    std::vector<SessionRecord> records = makeRecords(40, 8);
+    storeRecords(directory, records);
+
+    // El "disco" se llena 13 bytes después del registro 50: el lote que
+    // cruza ese punto queda escrito a medias
+    std::signal(SIGXFSZ, SIG_IGN);
+    rlimit previous;
+    getrlimit(RLIMIT_FSIZE, &previous);
+    rlimit limit = previous;
+    limit.rlim_cur = 50 * SessionFormat::RECORD_SIZE + 13;
+    setrlimit(RLIMIT_FSIZE, &limit);
+    std::vector<SessionRecord> lost = makeRecords(30, 9);
+    for (SessionRecord& record : lost) record.timestamp += 1000;
+    storeRecords(directory, lost);
+    setrlimit(RLIMIT_FSIZE, &previous);
+
+    std::uintmax_t size = std::filesystem::file_size(directory + "/sessions.log");
+    if (size % SessionFormat::RECORD_SIZE != 0 || size > 50 * SessionFormat::RECORD_SIZE) {
+        std::cerr << "write_failure: el log quedó con " << size << " bytes" << std::endl;
+        return false;
+    }
+    // Los lotes que entraron completos siguen en el log
+    std::size_t kept = size / SessionFormat::RECORD_SIZE - records.size();
+    records.insert(records.end(), lost.begin(), lost.begin() + kept);
+    std::filesystem::remove(directory + "/sessions.idx");
+    if (!reopenMatches("write_failure", directory, records)) return false;
+
+    // Con espacio otra vez, lo siguiente queda alineado
+    std::vector<SessionRecord> more = makeRecords(5, 10);
+    for (SessionRecord& record : more) record.timestamp += 2000;
+    storeRecords(directory, more);
+    records.insert(records.end(), more.begin(), more.end());
+    std::filesystem::remove(directory + "/sessions.idx");
+    return reopenMatches("write_failure", directory, records);
+#else
+    return true;
+#endif
+}
+
+int main() {
+    const TestCase tests[] = {
+        {"torn_tail", tornTailIsTruncated},
+        {"damaged_record", damagedRecordIsSkipped},
+        {"stale_index", staleIndexIsRebuilt},
+        {"submit_not_blocked", submitIsNotBlocked},
+        {"write_failure", writeFailureKeepsLogAligned},
+    };
+    return runTests(tests);
+}
@@ -0,0 +1,121 @@
+// ============================================================
+// SNAKE vs BLOCKS - Pruebas de la transmisión para espectadores
+// ============================================================
+// - feed_is_consistent: un lector que consulta mientras el juego publica
+//   nunca acepta una instantánea mezclada (en memoria normal).
+// - region_ownership: una segunda instancia no toma la región de un juego
+//   vivo, pero sí la que dejó uno que murió sin cerrarla.
+// ============================================================
+
+#include "test_helpers.hpp"
+#include "../src/autopilot.hpp"
+#include "../src/spectator_feed.hpp"
+#include <atomic>             // Fin del escritor
+#include <cstdlib>            // abs
+#include <thread>             // Escritor y lector
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/wait.h>         // waitpid (juego que muere sin cerrar)
+#include <unistd.h>           // fork, _exit
+#endif
+
+// Un lector que consulta la transmisión mientras el juego publica nunca
+// acepta una instantánea mezclada: la serpiente que ve es contigua y los
+// números de instantánea no retroceden (en memoria normal, sin región
+// del sistema)
+bool spectatorFeedIsConsistent() {
+    std::vector<unsigned char> memory(sizeof(FeedRegion));
+    SpectatorWriter writer(memory.data(), 1);
+    SpectatorReader reader(memory.data());
+    std::atomic<bool> done{false};
+    std::thread game([&] {
+        GameState state(7);
+        for (int tick = 0; tick < 20000; tick++) {
+            state.nextDirection = autopilotDirection(state);
+            state.update(0.016f);
+            if (state.gameOver) state.reset(tick);
+            writer.publish(state);
+            if (tick % 4 == 0) std::this_thread::yield();   // Con un solo núcleo, darle turno al lector
+        }
+        done = true;
+    });
+
+    static SpectatorSnapshot snapshot;
+    long reads = 0, torn = 0;
+    std::uint64_t lastFrame = 0;
+    bool ok = reader.compatible();
+    while (ok && !done) {
+        std::this_thread::yield();
+        if (reader.published() == 0) continue;
+        if (!reader.copy(snapshot, 1)) {
+            torn++;
+            continue;
+        }
+        reads++;
+        if (snapshot.frame < lastFrame || snapshot.snakeLength == 0) ok = false;
+        lastFrame = snapshot.frame;
+        for (std::uint32_t i = 1; ok && i < snapshot.snakeLength; i++) {
+            int dx = std::abs(snapshot.snake[i].x - snapshot.snake[i - 1].x);
+            int dy = std::abs(snapshot.snake[i].y - snapshot.snake[i - 1].y);
+            bool wrapped = dx == snapshot.cols - 1 || dy == snapshot.rows - 1;
+            if (dx + dy != 1 && !(wrapped && (dx == 0 || dy == 0))) ok = false;
+        }
+    }
+    game.join();
+    if (!ok || reads == 0) {
+        std::cerr << "spectator: instantánea inconsistente (frame " << snapshot.frame << ", " << reads
+                  << " lecturas)" << std::endl;
+        return false;
+    }
+    if (reader.published() != 20000 || !reader.copy(snapshot) || snapshot.frame != 19999) {
+        std::cerr << "spectator: la última instantánea no es la publicada" << std::endl;
+        return false;
+    }
+    std::cout << "     " << reads << " lecturas, " << torn << " descartadas" << std::endl;
+    return true;
+}
+
+// La región es del juego que la creó mientras viva; si muere sin cerrarla
+// (en POSIX el nombre queda en /dev/shm) la siguiente instancia la reclama
+bool regionOwnershipIsChecked() {
+    const char* name = "snake_vs_blocks_spectator_test";
+    SharedMemory::remove(name);
+    {
+        SpectatorFeed running, second;
+        if (!running.open(name) || second.open(name)) {
+            std::cerr << "ownership: una segunda instancia tomó la región de un juego vivo" << std::endl;
+            return false;
+        }
+    }
+#ifndef _WIN32
+    pid_t child = fork();
+    if (child == 0) {
+        static SpectatorFeed crashed;
+        _exit(crashed.open(name) ? 0 : 1);    // Sin destructores: la región queda
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    SharedMemory leftover;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || !leftover.open(name, sizeof(FeedRegion))) {
+        std::cerr << "ownership: el proceso hijo no dejó la región" << std::endl;
+        return false;
+    }
+    leftover.close();
+    SpectatorFeed restarted;
+    if (!restarted.open(name)) {
+        std::cerr << "ownership: no se reclamó la región de un juego que murió" << std::endl;
+        SharedMemory::remove(name);
+        return false;
+    }
+#endif
+    return true;
+}
+
+int main() {
+    const TestCase tests[] = {
+        {"spectator_feed_is_consistent", spectatorFeedIsConsistent},
+        {"region_ownership", regionOwnershipIsChecked},
+    };
+    return runTests(tests);
+}
@@ -0,0 +1,68 @@
+// ============================================================
+// SNAKE vs BLOCKS - Utilidades comunes de las pruebas
+// ============================================================
+// Cada archivo tests/*_test.cpp es un ejecutable que prueba un
+// subsistema; todos comparten:
+// - runTests(): corre una lista de pruebas, muestra "ok"/"FAIL" por
+//   cada una y devuelve el código de salida.
+// - placeSnake()/placeCells(): arman un tablero sin simular.
+// - nextRandom(): xorshift para entradas pseudoaleatorias reproducibles.
+// ============================================================
+#pragma once
+
+#include "../src/game_state.hpp"
+#include <iostream>           // Salida por consola
+
+struct TestCase {
+    const char* name;
+    bool (*run)();                // true si pasó (los detalles van a cerr)
+};
+
+template <int N>
+int runTests(const TestCase (&tests)[N]) {
+    calculateScaling();
+    int failures = 0;
+    for (const TestCase& test : tests) {
+        bool ok = test.run();
+        std::cout << (ok ? "ok   " : "FAIL ") << test.name << std::endl;
+        failures += !ok;
+    }
+    if (failures > 0) std::cout << failures << " prueba(s) fallaron" << std::endl;
+    return failures > 0 ? 1 : 0;
+}
+
+inline unsigned nextRandom(unsigned& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// Serpiente en forma de S de 10 celdas de ancho hacia la izquierda de la
+// cabeza (el resto del tablero queda vacío)
+template <class Game>
+void placeSnake(Game& game, int headX, int headY, int length) {
+    game.cells.fill(CELL_EMPTY);
+    game.snake.clear();
+    for (int i = 0; i < length; i++) {
+        int row = i / 10, col = i % 10;
+        int x = headX - (row % 2 == 0 ? col : 9 - col);
+        int y = headY + row;
+        game.snake.push_back(SnakeSegment(x, y));
+        game.cells[Game::cellIndex(x, y)] = CELL_SNAKE;
+    }
+}
+
+// 'count' celdas de 'type' desde (firstX, firstY) con el paso dado,
+// saltando las ocupadas
+template <class Game>
+void placeCells(Game& game, int count, int firstX, int firstY, int stepX, int stepY, CellType type) {
+    for (int i = 0; i < count; i++) {
+        int x = (firstX + i * stepX) % Game::BOARD_COLS;
+        int y = (firstY + i * stepY) % Game::BOARD_ROWS;
+        if (game.cells[Game::cellIndex(x, y)] != CELL_EMPTY) continue;
+        game.cells[Game::cellIndex(x, y)] = type;
+        if (type == CELL_APPLE) game.blocks.push_back(Block(x, y));
+        else if (type == CELL_OBSTACLE) game.obstacles.push_back(Obstacle(x, y));
+    }
+}
@@ -0,0 +1,239 @@
+// ============================================================
+// SNAKE vs BLOCKS - Pruebas de la rueda de temporizadores
+// ============================================================
+// TimerWheel contra un modelo simple (un vencimiento por id, revisado
+// en cada tick):
+// - exact_deadlines: retrasos en los bordes de cada uno de los 4 niveles
+//   (63/64/65, 4095/4096/4097, ...) y el máximo vencen en su tick exacto.
+// - cascade_matches_model: muchos temporizadores con retrasos de todos los
+//   niveles, reprogramados y cancelados al azar durante 600000 ticks.
+// - cancel: un temporizador cancelado no vence, ni en un nivel superior
+//   antes de bajar ni desde la llamada de otro que vence en el mismo tick.
+// - reschedule_in_callback: onExpire vuelve a programar su id (también con
+//   retraso 0 y con retrasos que cruzan niveles) y otros ids.
+// ============================================================
+
+#include "test_helpers.hpp"
+#include "../src/timer_wheel.hpp"
+#include <algorithm>          // sort
+#include <cstdint>
+#include <vector>
+
+using Wheel = TimerWheel<64>;
+const int IDS = 64;
+
+// Un vencimiento por id; avanzar revisa todos
+struct ReferenceTimers {
+    std::uint32_t deadline[IDS] = {};
+    bool active[IDS] = {};
+    std::uint32_t current = 0;
+
+    void schedule(int id, std::uint32_t delay) {
+        if (delay < 1) delay = 1;
+        if (delay > Wheel::MAX_DELAY) delay = Wheel::MAX_DELAY;
+        deadline[id] = current + delay;
+        active[id] = true;
+    }
+    void cancel(int id) { active[id] = false; }
+
+    std::vector<int> advance() {
+        current++;
+        std::vector<int> due;
+        for (int id = 0; id < IDS; id++) {
+            if (active[id] && deadline[id] == current) {
+                active[id] = false;
+                due.push_back(id);
+            }
+        }
+        return due;
+    }
+};
+
+bool exactDeadlines() {
+    const std::uint32_t delays[] = {1, 2, 63, 64, 65, 127, 4095, 4096, 4097, 4160,
+                                    262143, 262144, 262145, 300000, Wheel::MAX_DELAY};
+    // Empezar a mitad de las casillas de cada nivel para que los
+    // vencimientos no queden alineados con las vueltas
+    for (std::uint32_t start : {0u, 1000u, 262100u}) {
+        Wheel wheel;
+        for (std::uint32_t i = 0; i < start; i++) wheel.advance([](int) {});
+        int count = static_cast<int>(sizeof(delays) / sizeof(delays[0]));
+        for (int id = 0; id < count; id++) wheel.schedule(id, delays[id]);
+        if (wheel.remaining(count - 1) != Wheel::MAX_DELAY) {
+            std::cerr << "exact: remaining() del máximo es " << wheel.remaining(count - 1) << std::endl;
+            return false;
+        }
+
+        std::vector<int> fired(count, 0);
+        bool ok = true;
+        for (std::uint32_t tick = 1; tick <= Wheel::MAX_DELAY && ok; tick++) {
+            wheel.advance([&](int id) {
+                fired[id]++;
+                if (tick != delays[id]) {
+                    std::cerr << "exact: retraso " << delays[id] << " (desde " << start << ") venció a los "
+                              << tick << " ticks" << std::endl;
+                    ok = false;
+                }
+            });
+        }
+        for (int id = 0; id < count && ok; id++) {
+            if (fired[id] != 1 || wheel.active(id)) {
+                std::cerr << "exact: retraso " << delays[id] << " venció " << fired[id] << " veces" << std::endl;
+                ok = false;
+            }
+        }
+        if (!ok) return false;
+    }
+
+    // Más que el máximo se acorta al máximo
+    Wheel wheel;
+    wheel.schedule(0, Wheel::MAX_DELAY + 1000);
+    if (wheel.remaining(0) != Wheel::MAX_DELAY) {
+        std::cerr << "exact: un retraso mayor que MAX_DELAY quedó en " << wheel.remaining(0) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool cascadeMatchesModel() {
+    Wheel wheel;
+    ReferenceTimers model;
+    unsigned random = 99;
+    // Retrasos de los 4 niveles (hasta 300000 ticks, pasando la vuelta del nivel 2)
+    auto randomDelay = [&]() -> std::uint32_t {
+        switch (nextRandom(random) % 4) {
+            case 0: return nextRandom(random) % 64;
+            case 1: return nextRandom(random) % 4096;
+            case 2: return nextRandom(random) % 262144;
+            default: return 262144 + nextRandom(random) % 40000;
+        }
+    };
+    for (int id = 0; id < IDS; id++) {
+        std::uint32_t delay = randomDelay();
+        wheel.schedule(id, delay);
+        model.schedule(id, delay);
+    }
+
+    std::vector<int> fired;
+    for (int tick = 1; tick <= 600000; tick++) {
+        fired.clear();
+        wheel.advance([&](int id) { fired.push_back(id); });
+        std::vector<int> expected = model.advance();
+        std::sort(fired.begin(), fired.end());
+        if (fired != expected) {
+            std::cerr << "cascade: en el tick " << tick << " vencieron " << fired.size() << " (el modelo: "
+                      << expected.size() << ")" << std::endl;
+            return false;
+        }
+        // Los que vencieron vuelven a empezar; de vez en cuando uno de los
+        // primeros 8 se reprograma o se cancela (los demás llegan a vencer
+        // aunque estén a 300000 ticks)
+        for (int id : fired) {
+            std::uint32_t delay = randomDelay();
+            wheel.schedule(id, delay);
+            model.schedule(id, delay);
+        }
+        unsigned roll = nextRandom(random);
+        if (roll % 16 == 0) {
+            int id = static_cast<int>((roll >> 8) % 8);
+            if (roll & 16) {
+                wheel.cancel(id);
+                model.cancel(id);
+            } else {
+                std::uint32_t delay = randomDelay();
+                wheel.schedule(id, delay);
+                model.schedule(id, delay);
+            }
+        }
+        if (tick % 997 == 0) {
+            for (int id = 0; id < IDS; id++) {
+                std::uint32_t expectedLeft = model.active[id] ? model.deadline[id] - model.current : 0;
+                if (wheel.active(id) != model.active[id] || wheel.remaining(id) != expectedLeft) {
+                    std::cerr << "cascade: id " << id << " en el tick " << tick << " tiene remaining() "
+                              << wheel.remaining(id) << " (el modelo: " << expectedLeft << ")" << std::endl;
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool cancelStopsTimers() {
+    Wheel wheel;
+    wheel.schedule(0, 10);          // Nivel 0
+    wheel.schedule(1, 5000);        // Nivel 2: se cancela antes de bajar
+    wheel.schedule(2, 300000);      // Nivel 3
+    wheel.schedule(3, 20);          // Vencen juntos: el primero que
+    wheel.schedule(4, 20);          // llegue cancela al otro
+    wheel.cancel(0);
+    wheel.cancel(1);
+    wheel.cancel(2);
+    wheel.cancel(2);                // Cancelar dos veces no rompe las listas
+    if (wheel.active(0) || wheel.remaining(1) != 0) {
+        std::cerr << "cancel: sigue activo después de cancel()" << std::endl;
+        return false;
+    }
+
+    int fired[5] = {};
+    for (int tick = 1; tick <= 310000; tick++) {
+        wheel.advance([&](int id) {
+            fired[id]++;
+            if (id == 3) wheel.cancel(4);
+            if (id == 4) wheel.cancel(3);
+        });
+    }
+    if (fired[0] || fired[1] || fired[2] || fired[3] + fired[4] != 1) {
+        std::cerr << "cancel: vencieron " << fired[0] << "/" << fired[1] << "/" << fired[2] << " cancelados y "
+                  << fired[3] + fired[4] << " de los dos simultáneos" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool rescheduleInCallback() {
+    Wheel wheel;
+    wheel.schedule(0, 1);           // Cada tick (reprogramado con retraso 0: se acorta a 1)
+    wheel.schedule(1, 64);          // Cada 64 ticks: siempre entra al nivel 1
+    wheel.schedule(2, 4096);        // Cada 4096: nivel 2
+    wheel.schedule(3, 7);           // Programa al 4 con el mismo retraso y el 4 al 3
+    std::vector<std::uint32_t> ticks[5];
+    const int TICKS = 20000;
+    for (int tick = 1; tick <= TICKS; tick++) {
+        wheel.advance([&](int id) {
+            ticks[id].push_back(wheel.now());
+            if (id == 0) wheel.schedule(0, 0);
+            else if (id == 1) wheel.schedule(1, 64);
+            else if (id == 2) wheel.schedule(2, 4096);
+            else if (id == 3) wheel.schedule(4, 7);
+            else if (id == 4) wheel.schedule(3, 7);
+        });
+    }
+    auto periodic = [&](int id, std::uint32_t first, std::uint32_t period) {
+        const std::vector<std::uint32_t>& got = ticks[id];
+        if (got.size() != (TICKS - first) / period + 1) return false;
+        for (std::size_t i = 0; i < got.size(); i++) {
+            if (got[i] != first + i * period) return false;
+        }
+        return true;
+    };
+    // 3 y 4 se turnan cada 7 ticks
+    bool alternating = ticks[3].size() + ticks[4].size() == TICKS / 7;
+    for (std::size_t i = 0; i < ticks[3].size() && alternating; i++) alternating = ticks[3][i] == 7 + i * 14;
+    if (!periodic(0, 1, 1) || !periodic(1, 64, 64) || !periodic(2, 4096, 4096) || !alternating) {
+        std::cerr << "reschedule: vencimientos " << ticks[0].size() << "/" << ticks[1].size() << "/"
+                  << ticks[2].size() << "/" << ticks[3].size() << "+" << ticks[4].size() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    const TestCase tests[] = {
+        {"exact_deadlines", exactDeadlines},
+        {"cascade_matches_model", cascadeMatchesModel},
+        {"cancel", cancelStopsTimers},
+        {"reschedule_in_callback", rescheduleInCallback},
+    };
+    return runTests(tests);
+}
@@ -0,0 +1,117 @@
+// ============================================================
+// SNAKE vs BLOCKS - Lector de referencia de la transmisión
+// ============================================================
+// Ejemplo de cliente de la memoria compartida que publica el juego con
+// --spectator (ver spectator_layout.hpp): muestra una línea por cada
+// instantánea nueva y, con --board, el tablero en texto.
+//
+// Uso:
+//   main.exe --spectator            (en otra consola)
+//   spectator_reader.exe [--interval=100] [--count=N] [--board]
+//
+// El juego nunca espera al lector: si éste tarda, simplemente se salta
+// instantáneas y siempre lee la más reciente.
+// ============================================================
+
+#include "../src/spectator_layout.hpp"  // Formato de la región y SpectatorReader
+#include "../src/shared_memory.hpp"
+#include <algorithm>          // max
+#include <chrono>             // Intervalo de consulta
+#include <cstdio>             // printf
+#include <cstdlib>            // atoi
+#include <string>
+#include <thread>             // sleep_for
+
+// Resumen que se extrae en su lugar, sin copiar la instantánea
+struct FeedSummary {
+    std::uint64_t frame;
+    std::int32_t score, applesEaten, speedLevel;
+    std::uint32_t snakeLength, itemCount;
+    FeedPoint head;
+    float powerUpSeconds[FEED_POWERUP_COUNT];
+    bool gameOver;
+};
+
+const char* const POWERUP_NAMES[FEED_POWERUP_COUNT] = {"WALL", "DOUBLE", "MAGNET", "DESTROYER"};
+
+// Tablero en texto: S serpiente (@ cabeza), A manzana, # obstáculo, P power-up
+void printBoard(const SpectatorSnapshot& s) {
+    static char grid[SpectatorSnapshot::MAX_CELLS];
+    int cols = s.cols, rows = s.rows;
+    if (cols * rows > SpectatorSnapshot::MAX_CELLS) return;
+    for (int i = 0; i < cols * rows; i++) grid[i] = '.';
+    auto put = [&](int x, int y, char c) {
+        if (x < cols && y < rows) grid[y * cols + x] = c;
+    };
+    for (std::uint32_t i = 0; i < s.itemCount; i++) {
+        const FeedItem& item = s.items[i];
+        put(item.x, item.y, item.cell == FEED_CELL_APPLE ? 'A' : item.cell == FEED_CELL_OBSTACLE ? '#' : 'P');
+    }
+    for (std::uint32_t i = 0; i < s.snakeLength; i++) put(s.snake[i].x, s.snake[i].y, i == 0 ? '@' : 'S');
+    for (int y = 0; y < rows; y++) std::printf("%.*s\n", cols, grid + y * cols);
+}
+
+int main(int argc, char* argv[]) {
+    int intervalMs = 100;
+    long maxCount = 0;            // 0: sin límite
+    bool board = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--interval=", 0) == 0) intervalMs = std::max(1, std::atoi(arg.c_str() + 11));
+        else if (arg.rfind("--count=", 0) == 0) maxCount = std::atol(arg.c_str() + 8);
+        else if (arg == "--board") board = true;
+        else {
+            std::fprintf(stderr, "Uso: spectator_reader [--interval=100] [--count=N] [--board]\n");
+            return 1;
+        }
+    }
+
+    // Esperar a que el juego cree la región
+    SharedMemory memory;
+    while (!memory.open(FEED_NAME, sizeof(FeedRegion))) {
+        std::printf("Esperando al juego (main.exe --spectator)...\n");
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+    SpectatorReader reader(memory.data());
+    if (!reader.compatible()) {
+        std::fprintf(stderr, "Error: la transmisión es de otra versión (se esperaba la %u)\n", FEED_LAYOUT_VERSION);
+        return 1;
+    }
+
+    static SpectatorSnapshot snapshot;    // Solo con --board (48 KB, fuera de la pila)
+    std::uint64_t lastSeen = 0;
+    long shown = 0;
+    while (maxCount == 0 || shown < maxCount) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+        std::uint64_t published = reader.published();
+        if (published == lastSeen) continue;
+
+        FeedSummary summary;
+        bool ok = reader.view([&summary](const SpectatorSnapshot& s) {
+            summary.frame = s.frame;
+            summary.score = s.score;
+            summary.applesEaten = s.applesEaten;
+            summary.speedLevel = s.speedLevel;
+            summary.snakeLength = s.snakeLength;
+            summary.itemCount = s.itemCount;
+            summary.head = s.snake[0];
+            summary.gameOver = s.gameOver != 0;
+            for (int t = 0; t < FEED_POWERUP_COUNT; t++) summary.powerUpSeconds[t] = s.powerUpSeconds[t];
+        });
+        if (!ok) continue;  // Se cruzó con una escritura: probar en la próxima vuelta
+        lastSeen = published;
+        shown++;
+
+        std::printf("#%llu score %d apples %d speed %d length %u head (%u, %u) items %u%s",
+                    static_cast<unsigned long long>(summary.frame), summary.score, summary.applesEaten,
+                    summary.speedLevel, summary.snakeLength, summary.head.x, summary.head.y, summary.itemCount,
+                    summary.gameOver ? " GAME OVER" : "");
+        for (int t = 0; t < FEED_POWERUP_COUNT; t++) {
+            if (summary.powerUpSeconds[t] > 0) std::printf(" %s %.1fs", POWERUP_NAMES[t], summary.powerUpSeconds[t]);
+        }
+        std::printf("\n");
+        if (board && reader.copy(snapshot)) printBoard(snapshot);
+        std::fflush(stdout);
+    }
+    return 0;
+}